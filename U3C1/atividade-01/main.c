@@ -7,6 +7,14 @@
 
 // --- Configuração dos Pinos ---
 #define SERVO_PIN 2
+#define SERVO_MIN_PULSE_US 500
+#define SERVO_MAX_PULSE_US 2500
+
+// Perfil do comando do servo (pulso em us): a velocidade de rotação muda
+// em rampa em S, a cada quadro de PWM, em vez de saltar a cada 100 ms
+#define SERVO_VEL_MAX_US_S 4000
+#define SERVO_ACEL_MAX_US_S2 20000
+#define SERVO_JERK_MAX_US_S3 200000
 #define I2C_PORT i2c0
 #define I2C_SDA 0
 #define I2C_SCL 1
@@ -30,7 +38,18 @@ int main() {
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
     bh1750_init(I2C_PORT);
-    servo_init(SERVO_PIN);
+
+    // Slice e canal do servo são calculados uma vez, no registro
+    static servo_manager_t servos;
+    servo_manager_init(&servos);
+    int servo = servo_manager_add(&servos, SERVO_PIN, SERVO_MIN_PULSE_US, SERVO_MAX_PULSE_US);
+    servo_manager_start(&servos);
+
+    const servo_limits_t limites = {
+        SERVO_PROFILE_S_CURVE, SERVO_VEL_MAX_US_S, SERVO_ACEL_MAX_US_S2, SERVO_JERK_MAX_US_S3
+    };
+    servo_manager_set_limits(&servos, (uint)servo, &limites);
+    servo_manager_enable_frame_irq(&servos);
     
     printf("Sistema iniciado. Controlando velocidade do servo com sensor BH1750...\n");
 
@@ -71,7 +90,7 @@ int main() {
             if (command_angle < 0.0f) command_angle = 0.0f;
             if (command_angle > 180.0f) command_angle = 180.0f;
 
-            servo_set_angle(SERVO_PIN, command_angle);
+            servo_manager_move_to_angle(&servos, (uint)servo, (int32_t)(command_angle * 10.0f));
         }
 
         sleep_ms(100);
@@ -17,6 +17,89 @@ class MPU6050 {
       float z;
     } VECT_3D;
 
+    // Amostra completa de uma única leitura em rajada (14 bytes)
+    typedef struct {
+      uint64_t timestamp_us;  // instante da leitura (time_us_64)
+      int16_t  accel_raw[3];
+      int16_t  temp_raw;
+      int16_t  gyro_raw[3];
+      VECT_3D  accel;         // g
+      VECT_3D  gyro;          // graus por segundo
+      float    temp;          // C
+    } Sample;
+
+    // Faixa do acelerômetro (AFS_SEL)
+    enum class AccelRange : uint8_t { G2 = 0, G4 = 1, G8 = 2, G16 = 3 };
+
+    // Faixa do giroscópio (FS_SEL)
+    enum class GyroRange : uint8_t { DPS250 = 0, DPS500 = 1, DPS1000 = 2, DPS2000 = 3 };
+
+    // Filtro passa-baixas digital (DLPF_CFG), banda do acelerômetro
+    enum class Dlpf : uint8_t { HZ260 = 0, HZ184 = 1, HZ94 = 2, HZ44 = 3, HZ21 = 4, HZ10 = 5, HZ5 = 6 };
+
+    // Passa-altas do acelerômetro usado pela detecção de movimento (ACCEL_HPF)
+    enum class AccelHpf : uint8_t { OFF = 0, HZ5 = 1, HZ2_5 = 2, HZ1_25 = 3, HZ0_63 = 4, HOLD = 7 };
+
+    // Bits de INT_PIN_CFG
+    static constexpr uint8_t INT_ACTIVE_LOW = 0x80;
+    static constexpr uint8_t INT_OPEN_DRAIN = 0x40;
+    static constexpr uint8_t INT_LATCH      = 0x20;
+    static constexpr uint8_t INT_ANY_READ   = 0x10;   // qualquer leitura limpa o status
+
+    // Bits de INT_ENABLE e INT_STATUS
+    static constexpr uint8_t INT_FREE_FALL  = 0x80;
+    static constexpr uint8_t INT_MOTION     = 0x40;
+    static constexpr uint8_t INT_FIFO_OFLOW = 0x10;
+    static constexpr uint8_t INT_DATA_READY = 0x01;
+
+    // Configuração completa do sensor; o padrão é o mesmo do begin() original
+    // (DLPF desligado, +/- 2 g, +/- 500 graus/s, 8 kHz no giroscópio)
+    struct Config {
+      AccelRange accelRange = AccelRange::G2;
+      GyroRange  gyroRange = GyroRange::DPS500;
+      Dlpf       dlpf = Dlpf::HZ260;
+      uint8_t    sampleRateDiv = 0;   // taxa = taxa do giroscópio / (1 + div)
+      uint8_t    intPinCfg = 0;       // INT_ACTIVE_LOW | INT_LATCH | ...
+      uint8_t    intEnable = 0;       // INT_DATA_READY | INT_MOTION | ...
+      AccelHpf   accelHpf = AccelHpf::OFF;
+      uint8_t    motionThreshold = 0;     // 2 mg por LSB, sobre a aceleração filtrada pelo passa-altas
+      uint8_t    motionDuration = 0;      // ms acima do limiar até gerar a interrupção
+      uint8_t    freeFallThreshold = 0;   // 2 mg por LSB
+      uint8_t    freeFallDuration = 0;    // ms
+
+      // LSB por g: 16384, 8192, 4096, 2048
+      constexpr int32_t accelLsbPerG() const {
+        return 16384 >> static_cast<uint8_t>(accelRange);
+      }
+
+      // LSB por grau/s, multiplicado por 10: 1310, 655, 328, 164
+      constexpr int32_t gyroLsbPerDpsX10() const {
+        return gyroRange == GyroRange::DPS250 ? 1310 :
+               gyroRange == GyroRange::DPS500 ? 655 :
+               gyroRange == GyroRange::DPS1000 ? 328 : 164;
+      }
+
+      constexpr float accelScale() const {
+        return static_cast<float>(accelLsbPerG());
+      }
+
+      constexpr float gyroScale() const {
+        return static_cast<float>(gyroLsbPerDpsX10()) / 10.0f;
+      }
+
+      // Taxa de amostragem em Hz (o giroscópio roda a 8 kHz só com o DLPF desligado)
+      constexpr uint32_t sampleRateHz() const {
+        return (dlpf == Dlpf::HZ260 ? 8000u : 1000u) / (1u + sampleRateDiv);
+      }
+    };
+
+    // Bloco de registradores SMPLRT_DIV (0x19) .. INT_ENABLE (0x38), precedido
+    // do endereço inicial, pronto para uma única escrita em rajada
+    static constexpr int CONFIG_BLOCK_LEN = 0x38 - 0x19 + 1;
+    struct ConfigImage {
+      uint8_t bytes[1 + CONFIG_BLOCK_LEN];
+    };
+
     // Endereço I2C padrão
     static const uint8_t I2C_ADDR = 0x68;
 
@@ -27,27 +110,79 @@ class MPU6050 {
     MPU6050 (i2c_inst_t *i2c, uint8_t addr = MPU6050::I2C_ADDR);
 
     // Métodos públicos
-    void    begin(void);
+    bool    begin(void);
+    bool    begin(const Config &config);
+    bool    configure(const Config &config);
+    const Config &getConfig(void) const;
     uint8_t getId(void);
     void    reset(void);
-    void    getAccel(VECT_3D *vect, float scale = 16384.0);
-    void    getGyro(VECT_3D *vect, float scale = 65.5);
+    int     readIntStatus(void);
+    bool    read(Sample &sample);
+    bool    read(Sample &sample, float accelScale, float gyroScale);
+
+    // Valores da última leitura (read), sem acesso ao barramento.
+    // Sem escala explícita, usa a da configuração aplicada.
+    void    getAccel(VECT_3D *vect);
+    void    getAccel(VECT_3D *vect, float scale);
+    void    getGyro(VECT_3D *vect);
+    void    getGyro(VECT_3D *vect, float scale);
     float   getTemp();
+    uint64_t getTimestamp(void);
+
+    // Monta a imagem dos registradores de uma configuração.
+    // Com uma Config constexpr, é calculada em tempo de compilação.
+    static constexpr ConfigImage encode(const Config &c);
 
   private:
-    
+
     // Endereços dos registradores
-    static const int SMPLRT_DIV = 0x19;
-    static const int CONFIG = 0x1A;
-    static const int GYRO_CONFIG = 0x1B;
-    static const int ACCEL_CONFIG = 0x1C;
-    static const int ACCEL_OUT = 0x3B;
-    static const int TEMP_OUT = 0x41;
-    static const int GYRO_OUT = 0x43;
-    static const int SIG_PATH_RESET = 0x68;
-    static const int PWR_MGMT_1 = 0x6B;
-    static const int PWR_MGMT_2 = 0x6C;
-    static const int WHO_AM_I = 0x75;
+    static constexpr uint8_t SMPLRT_DIV = 0x19;
+    static constexpr uint8_t CONFIG = 0x1A;
+    static constexpr uint8_t GYRO_CONFIG = 0x1B;
+    static constexpr uint8_t ACCEL_CONFIG = 0x1C;
+    static constexpr uint8_t FF_THR = 0x1D;
+    static constexpr uint8_t FF_DUR = 0x1E;
+    static constexpr uint8_t MOT_THR = 0x1F;
+    static constexpr uint8_t MOT_DUR = 0x20;
+    static constexpr uint8_t INT_PIN_CFG = 0x37;
+    static constexpr uint8_t INT_ENABLE = 0x38;
+    static constexpr uint8_t INT_STATUS = 0x3A;
+    static constexpr uint8_t ACCEL_OUT = 0x3B;
+    static constexpr uint8_t TEMP_OUT = 0x41;
+    static constexpr uint8_t GYRO_OUT = 0x43;
+    static constexpr uint8_t SIG_PATH_RESET = 0x68;
+    static constexpr uint8_t PWR_MGMT_1 = 0x6B;
+    static constexpr uint8_t PWR_MGMT_2 = 0x6C;
+    static constexpr uint8_t WHO_AM_I = 0x75;
+
+    // Campo de bits de um registrador
+    template <uint8_t REG, uint8_t SHIFT, uint8_t WIDTH>
+    struct Field {
+      static_assert(SHIFT + WIDTH <= 8, "campo fora do registrador");
+      static constexpr uint8_t reg = REG;
+      static constexpr uint8_t mask = static_cast<uint8_t>(((1u << WIDTH) - 1u) << SHIFT);
+
+      static constexpr uint8_t encode(uint8_t val) {
+        return static_cast<uint8_t>((val << SHIFT) & mask);
+      }
+    };
+
+    typedef Field<SMPLRT_DIV, 0, 8>   SMPLRT_DIV_F;
+    typedef Field<CONFIG, 0, 3>       DLPF_CFG_F;
+    typedef Field<GYRO_CONFIG, 3, 2>  FS_SEL_F;
+    typedef Field<ACCEL_CONFIG, 3, 2> AFS_SEL_F;
+    typedef Field<ACCEL_CONFIG, 0, 3> ACCEL_HPF_F;
+    typedef Field<FF_THR, 0, 8>       FF_THR_F;
+    typedef Field<FF_DUR, 0, 8>       FF_DUR_F;
+    typedef Field<MOT_THR, 0, 8>      MOT_THR_F;
+    typedef Field<MOT_DUR, 0, 8>      MOT_DUR_F;
+    typedef Field<INT_PIN_CFG, 0, 8>  INT_PIN_CFG_F;
+    typedef Field<INT_ENABLE, 0, 8>   INT_ENABLE_F;
+
+    // Posição de um registrador dentro da imagem de configuração
+    static constexpr int slot(uint8_t reg) {
+      return 1 + reg - SMPLRT_DIV;
+    }
 
     // Instância do I2C
     i2c_inst_t *i2c;
@@ -58,14 +193,47 @@ class MPU6050 {
     // Identificação do Sensor
     uint8_t id;
 
-    // Dados brutos
-    int16_t raw[14];
+    // Configuração aplicada e escalas derivadas dela
+    Config config;
+    float accelScale;
+    float gyroScale;
+
+    // Dados brutos da última leitura: accel x/y/z, temp, gyro x/y/z
+    int16_t raw[7];
+    uint64_t timestamp;
 
     // Rotinas privativas
-    void     readRaw(void);
+    bool     readRaw(void);
     uint8_t  read8(uint8_t reg);
     void     write8(uint8_t reg, uint8_t val);
+    bool     readRegs(uint8_t reg, uint8_t *dst, size_t len);
+    bool     writeRegs(const uint8_t *src, size_t len);
 };
 
-
-#endif // MPU6050__H
\ No newline at end of file
+// Todos os registradores do bloco que não fazem parte da Config ficam com o
+// valor de reset (0); os somente-leitura ignoram a escrita
+constexpr MPU6050::ConfigImage MPU6050::encode(const Config &c) {
+  ConfigImage img = {};
+
+  img.bytes[0] = SMPLRT_DIV;
+  img.bytes[slot(SMPLRT_DIV_F::reg)] |= SMPLRT_DIV_F::encode(c.sampleRateDiv);
+  img.bytes[slot(DLPF_CFG_F::reg)] |= DLPF_CFG_F::encode(static_cast<uint8_t>(c.dlpf));
+  img.bytes[slot(FS_SEL_F::reg)] |= FS_SEL_F::encode(static_cast<uint8_t>(c.gyroRange));
+  img.bytes[slot(AFS_SEL_F::reg)] |= AFS_SEL_F::encode(static_cast<uint8_t>(c.accelRange));
+  img.bytes[slot(ACCEL_HPF_F::reg)] |= ACCEL_HPF_F::encode(static_cast<uint8_t>(c.accelHpf));
+  img.bytes[slot(FF_THR_F::reg)] |= FF_THR_F::encode(c.freeFallThreshold);
+  img.bytes[slot(FF_DUR_F::reg)] |= FF_DUR_F::encode(c.freeFallDuration);
+  img.bytes[slot(MOT_THR_F::reg)] |= MOT_THR_F::encode(c.motionThreshold);
+  img.bytes[slot(MOT_DUR_F::reg)] |= MOT_DUR_F::encode(c.motionDuration);
+  img.bytes[slot(INT_PIN_CFG_F::reg)] |= INT_PIN_CFG_F::encode(c.intPinCfg);
+  img.bytes[slot(INT_ENABLE_F::reg)] |= INT_ENABLE_F::encode(c.intEnable);
+  return img;
+}
+
+// A configuração padrão reproduz os valores fixos usados antes
+static_assert(MPU6050::Config().accelScale() == 16384.0f, "escala padrao do acelerometro");
+static_assert(MPU6050::Config().gyroScale() == 65.5f, "escala padrao do giroscopio");
+static_assert(MPU6050::encode(MPU6050::Config()).bytes[1 + 0x1B - 0x19] == 0x08, "GYRO_CONFIG padrao");
+
+
+#endif // MPU6050__H
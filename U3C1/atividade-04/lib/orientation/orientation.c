@@ -0,0 +1,123 @@
+// orientation.c
+
+#include "orientation.h"
+
+#define DEG_90  ORIENTATION_DEG(90)
+#define DEG_180 ORIENTATION_DEG(180)
+#define DEG_360 ((int64_t)DEG_180 * 2)
+
+// Coeficientes do atan: atan(z) ~ 45z + z(1-z)(14,0202 + 3,7987z) graus, em Q12
+#define ATAN_C1 57427
+#define ATAN_C2 15559
+
+static inline int32_t wrap_180(int64_t a) {
+    while (a > DEG_180) a -= DEG_360;
+    while (a < -DEG_180) a += DEG_360;
+    return (int32_t)a;
+}
+
+uint32_t orientation_isqrt(uint32_t v) {
+    uint32_t res = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v) bit >>= 2;
+
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+int32_t orientation_atan2(int32_t y, int32_t x) {
+    uint32_t ax = x < 0 ? -(uint32_t)x : (uint32_t)x;
+    uint32_t ay = y < 0 ? -(uint32_t)y : (uint32_t)y;
+
+    if (ax == 0 && ay == 0) return 0;
+
+    // Reduz ao primeiro octante: z = menor/maior, em Q15
+    bool swap = ay > ax;
+    uint32_t num = swap ? ax : ay;
+    uint32_t den = swap ? ay : ax;
+    while (den >= 65536) {
+        num >>= 1;
+        den >>= 1;
+    }
+    int32_t z = (int32_t)((num << 15) / den);
+
+    int32_t w = (z * (32768 - z)) >> 15;            // z(1-z), Q15
+    int32_t c = ATAN_C1 + ((ATAN_C2 * z) >> 15);    // Q12
+    int32_t r = 90 * z + ((w * c) >> 11);           // 45z em Q16 = 90 * z(Q15)
+
+    if (swap) r = DEG_90 - r;
+    if (x < 0) r = DEG_180 - r;
+    if (y < 0) r = -r;
+    return r;
+}
+
+void orientation_init(orientation_t *o, const orientation_config_t *cfg) {
+    o->pitch = 0;
+    o->roll = 0;
+    o->yaw = 0;
+    o->gyro_bias[0] = o->gyro_bias[1] = o->gyro_bias[2] = 0;
+    o->tau_us = cfg->tau_ms * 1000u;
+    o->initialized = false;
+
+    // Q16 graus por (LSB * us), escalado por 2^32 para a multiplicação na atualização
+    o->gyro_mult = (uint32_t)(((1ull << 48) * 10u) / ((uint64_t)cfg->gyro_lsb_per_dps_x10 * 1000000u));
+
+    uint64_t g2 = (uint64_t)cfg->accel_lsb_per_g * cfg->accel_lsb_per_g;
+    uint64_t lo = g2 * (100 - cfg->accel_gate_pct) * (100 - cfg->accel_gate_pct) / 10000u;
+    uint64_t hi = g2 * (100 + cfg->accel_gate_pct) * (100 + cfg->accel_gate_pct) / 10000u;
+    o->gate_lo = (uint32_t)lo;
+    o->gate_hi = hi > UINT32_MAX ? UINT32_MAX : (uint32_t)hi;
+}
+
+void orientation_set_gyro_bias(orientation_t *o, const int32_t bias[3]) {
+    o->gyro_bias[0] = bias[0];
+    o->gyro_bias[1] = bias[1];
+    o->gyro_bias[2] = bias[2];
+}
+
+void orientation_update(orientation_t *o, const int16_t accel[3], const int16_t gyro[3], uint32_t dt_us) {
+    const int32_t ax = accel[0], ay = accel[1], az = accel[2];
+
+    // Ângulos vistos pelo acelerômetro (mesma convenção do atan2 em float do main)
+    const int32_t pitch_acc = orientation_atan2(-ax, (int32_t)orientation_isqrt((uint32_t)(ay * ay) + (uint32_t)(az * az)));
+    const int32_t roll_acc = orientation_atan2(ay, az);
+
+    if (!o->initialized) {
+        o->pitch = pitch_acc;
+        o->roll = roll_acc;
+        o->yaw = 0;
+        o->initialized = true;
+        return;
+    }
+
+    // Integração do giroscópio: roll <- x, pitch <- y, yaw <- z
+    const int64_t gx = (int64_t)(gyro[0] - o->gyro_bias[0]) * dt_us;
+    const int64_t gy = (int64_t)(gyro[1] - o->gyro_bias[1]) * dt_us;
+    const int64_t gz = (int64_t)(gyro[2] - o->gyro_bias[2]) * dt_us;
+
+    int32_t roll = wrap_180(o->roll + ((gx * o->gyro_mult) >> 32));
+    int32_t pitch = wrap_180(o->pitch + ((gy * o->gyro_mult) >> 32));
+    o->yaw = wrap_180(o->yaw + ((gz * o->gyro_mult) >> 32));
+
+    // Correção pelo acelerômetro só quando não há aceleração linear relevante
+    const uint32_t mag2 = (uint32_t)(ax * ax) + (uint32_t)(ay * ay) + (uint32_t)(az * az);
+    if (mag2 >= o->gate_lo && mag2 <= o->gate_hi) {
+        const uint32_t dt = dt_us > 65535 ? 65535 : dt_us;
+        const int32_t k = (int32_t)((dt << 16) / (o->tau_us + dt));  // Q16
+
+        pitch = wrap_180(pitch + (((int64_t)wrap_180((int64_t)pitch_acc - pitch) * k) >> 16));
+        roll = wrap_180(roll + (((int64_t)wrap_180((int64_t)roll_acc - roll) * k) >> 16));
+    }
+
+    o->pitch = pitch;
+    o->roll = roll;
+}
@@ -0,0 +1,89 @@
+// orientation.h
+
+#ifndef ORIENTATION_H
+#define ORIENTATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ângulos em ponto fixo Q16: 65536 unidades = 1 grau
+#define ORIENTATION_Q16_ONE   65536
+#define ORIENTATION_DEG(d)    ((int32_t)((d) * ORIENTATION_Q16_ONE))
+
+/**
+ * @brief Parâmetros do filtro, de acordo com a configuração do MPU6050.
+ */
+typedef struct {
+    int32_t accel_lsb_per_g;       // 16384 para +/- 2 g
+    int32_t gyro_lsb_per_dps_x10;  // 655 para +/- 500 graus/s (65,5 LSB por grau/s)
+    uint32_t tau_ms;               // constante de tempo do filtro complementar
+    int32_t accel_gate_pct;        // só corrige com o acelerômetro se |a| estiver a +/- N% de 1 g
+} orientation_config_t;
+
+/**
+ * @brief Estado do filtro complementar.
+ */
+typedef struct {
+    int32_t pitch;          // Q16 graus
+    int32_t roll;           // Q16 graus
+    int32_t yaw;            // Q16 graus (só giroscópio: deriva com o tempo)
+    int32_t gyro_bias[3];   // LSB brutos subtraídos do giroscópio
+    uint32_t gyro_mult;     // LSB * us -> Q16 graus, escalado por 2^32
+    uint32_t tau_us;
+    uint32_t gate_lo;       // faixa aceita de |a|^2 em LSB^2
+    uint32_t gate_hi;
+    bool initialized;
+} orientation_t;
+
+/**
+ * @brief Inicializa o filtro.
+ *
+ * Todos os fatores de escala são calculados aqui, para que a atualização
+ * use só inteiros de 32 bits e multiplicações.
+ */
+void orientation_init(orientation_t *o, const orientation_config_t *cfg);
+
+/**
+ * @brief Define o offset do giroscópio em LSB (medido com o sensor parado).
+ */
+void orientation_set_gyro_bias(orientation_t *o, const int32_t bias[3]);
+
+/**
+ * @brief Integra uma amostra bruta do MPU6050.
+ *
+ * @param accel Aceleração bruta x, y, z.
+ * @param gyro Velocidade angular bruta x, y, z.
+ * @param dt_us Tempo desde a amostra anterior, em microssegundos.
+ */
+void orientation_update(orientation_t *o, const int16_t accel[3], const int16_t gyro[3], uint32_t dt_us);
+
+/**
+ * @brief atan2 em ponto fixo.
+ *
+ * Aproximação polinomial com erro máximo de cerca de 0,1 grau.
+ *
+ * @return Ângulo em Q16 graus, de -180 a 180.
+ */
+int32_t orientation_atan2(int32_t y, int32_t x);
+
+/**
+ * @brief Raiz quadrada inteira (arredondada para baixo).
+ */
+uint32_t orientation_isqrt(uint32_t v);
+
+/**
+ * @brief Converte um ângulo Q16 para graus em float (apenas para exibição).
+ */
+static inline float orientation_to_deg(int32_t q16) {
+    return (float)q16 / ORIENTATION_Q16_ONE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ORIENTATION_H
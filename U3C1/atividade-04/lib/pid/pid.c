@@ -0,0 +1,57 @@
+// pid.c
+
+#include "pid.h"
+
+void pid_init(pid_controller_t *pid, const pid_config_t *cfg) {
+    pid->kp = cfg->kp;
+    pid->ki_dt = (int32_t)(((int64_t)cfg->ki * cfg->period_us) / 1000000);
+    pid->kd_dt = (int32_t)(((int64_t)cfg->kd * 1000000) / cfg->period_us);
+    pid->out_min = cfg->out_min;
+    pid->out_max = cfg->out_max;
+    pid->deadband = cfg->deadband;
+    pid_reset(pid);
+}
+
+void pid_reset(pid_controller_t *pid) {
+    pid->integ = 0;
+    pid->prev_meas = 0;
+    pid->first = true;
+    pid->saturated = false;
+}
+
+static inline int64_t pid_clamp(int64_t v, int64_t lo, int64_t hi) {
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+int32_t pid_update(pid_controller_t *pid, int32_t setpoint, int32_t measurement) {
+    int64_t lo = (int64_t)pid->out_min * PID_Q16_ONE;
+    int64_t hi = (int64_t)pid->out_max * PID_Q16_ONE;
+
+    int32_t err = setpoint - measurement;
+    if (err > -pid->deadband && err < pid->deadband) {
+        err = 0;
+    }
+
+    // Derivativo sobre a medida: d(erro)/dt = -d(medida)/dt com setpoint fixo
+    int32_t dmeas = pid->first ? 0 : measurement - pid->prev_meas;
+    pid->prev_meas = measurement;
+    pid->first = false;
+
+    int64_t p = (int64_t)pid->kp * err;
+    int64_t d = -(int64_t)pid->kd_dt * dmeas;
+
+    // Integração condicional: só acumula se a saída não estiver saturada no
+    // mesmo sentido do erro
+    int64_t integ = pid->integ + (int64_t)pid->ki_dt * err;
+    if (!(pid->saturated && ((err > 0 && p + pid->integ + d >= hi) ||
+                             (err < 0 && p + pid->integ + d <= lo)))) {
+        pid->integ = pid_clamp(integ, lo, hi);
+    }
+
+    int64_t out = p + pid->integ + d;
+    pid->saturated = out >= hi || out <= lo;
+    out = pid_clamp(out, lo, hi);
+
+    // Q16 -> unidades de saída, arredondando
+    return (int32_t)((out + (PID_Q16_ONE / 2)) >> 16);
+}
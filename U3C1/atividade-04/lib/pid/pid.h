@@ -0,0 +1,76 @@
+// pid.h
+
+#ifndef PID_H
+#define PID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Ganhos em ponto fixo Q16 (65536 = 1,0)
+#define PID_Q16_ONE   65536
+#define PID_GAIN(g)   ((int32_t)((g) * PID_Q16_ONE))
+
+/**
+ * @brief Parâmetros do controlador.
+ *
+ * Entrada (setpoint e medida) e saída podem estar em qualquer unidade
+ * inteira; os ganhos convertem uma na outra. Ki é por segundo e Kd em
+ * segundos: o período fixo já entra nos fatores calculados em pid_init.
+ */
+typedef struct {
+    int32_t kp;             // Q16, saída por unidade de erro
+    int32_t ki;             // Q16, saída por unidade de erro por segundo
+    int32_t kd;             // Q16, saída por unidade de erro por segundo de variação
+    uint32_t period_us;     // período fixo de chamada de pid_update
+    int32_t out_min;
+    int32_t out_max;
+    int32_t deadband;       // |erro| abaixo disso conta como zero (o integral é mantido)
+} pid_config_t;
+
+/**
+ * @brief Estado do controlador.
+ */
+typedef struct {
+    int32_t kp;
+    int32_t ki_dt;          // Ki * período, Q16
+    int32_t kd_dt;          // Kd / período, Q16
+    int32_t out_min;
+    int32_t out_max;
+    int32_t deadband;
+    int64_t integ;          // termo integral, em unidades de saída Q16
+    int32_t prev_meas;
+    bool first;
+    bool saturated;         // última saída foi limitada
+} pid_controller_t;
+
+/**
+ * @brief Inicializa o controlador e calcula os fatores por período.
+ */
+void pid_init(pid_controller_t *pid, const pid_config_t *cfg);
+
+/**
+ * @brief Zera o termo integral e a memória do derivativo.
+ */
+void pid_reset(pid_controller_t *pid);
+
+/**
+ * @brief Um passo do controlador, chamado a cada period_us.
+ *
+ * O derivativo usa a variação da medida (sem salto quando o setpoint muda).
+ * Anti-windup por integração condicional: com a saída saturada, o integral
+ * não cresce no sentido da saturação, e ele mesmo fica limitado à faixa
+ * de saída.
+ *
+ * @return Saída limitada a [out_min, out_max].
+ */
+int32_t pid_update(pid_controller_t *pid, int32_t setpoint, int32_t measurement);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PID_H
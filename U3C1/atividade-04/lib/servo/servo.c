@@ -1,8 +1,7 @@
-// servo.c
-
 #include "servo.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
+#include "hardware/irq.h"
 
 // --- Constantes para o servo motor SG90 ---
 
@@ -49,8 +48,7 @@ void servo_set_pulse_width(uint gpio_pin, uint32_t pulse_width_us) {
     uint channel_num = pwm_gpio_to_channel(gpio_pin);
 
     // Define o nível do canal, que corresponde diretamente à largura do pulso em us
-    // devido à nossa configuração de clock
-    // CORREÇÃO 2: A função correta é pwm_set_chan_level()
+    // devido à configuração de clock
     pwm_set_chan_level(slice_num, channel_num, pulse_width_us);
 }
 
@@ -63,4 +61,296 @@ void servo_set_angle(uint gpio_pin, float angle) {
     uint32_t pulse_width = MIN_PULSE_US + (uint32_t)((angle / 180.0f) * (MAX_PULSE_US - MIN_PULSE_US));
     
     servo_set_pulse_width(gpio_pin, pulse_width);
-}
\ No newline at end of file
+}
+
+// --- Gerenciador de vários servos ---
+
+// Se faltar menos que isso para o wrap, o apply espera o próximo período
+// (folga para escrever os 8 slices antes do wrap)
+#define SERVO_APPLY_MARGIN_US 20
+
+void servo_manager_init(servo_manager_t *m) {
+    m->count = 0;
+    m->slice_mask = 0;
+    m->dirty_mask = 0;
+    for (uint i = 0; i < SERVO_NUM_SLICES; i++) {
+        m->cc[i] = 0;
+    }
+    for (uint i = 0; i < SERVO_MAX_SERVOS; i++) {
+        m->motion[i].enabled = false;
+    }
+}
+
+int servo_manager_add(servo_manager_t *m, uint gpio, uint16_t min_us, uint16_t max_us) {
+    if (m->count >= SERVO_MAX_SERVOS || max_us <= min_us || max_us > PWM_WRAP_VALUE) {
+        return -1;
+    }
+
+    uint slice = pwm_gpio_to_slice_num(gpio);
+    uint channel = pwm_gpio_to_channel(gpio);
+    for (uint i = 0; i < m->count; i++) {
+        if (m->servos[i].slice == slice && m->servos[i].channel == channel) {
+            return -1;
+        }
+    }
+
+    servo_t *s = &m->servos[m->count];
+    s->gpio = gpio;
+    s->slice = slice;
+    s->channel = channel;
+    s->min_us = min_us;
+    s->max_us = max_us;
+    s->us_per_ddeg_q16 = ((uint32_t)(max_us - min_us) << 16) / 1800u;
+
+    // Mesmo clock e wrap do servo_init, mas sem ligar o slice ainda
+    if ((m->slice_mask & (1u << slice)) == 0) {
+        pwm_config config = pwm_get_default_config();
+        pwm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / 1000000.0f);
+        pwm_config_set_wrap(&config, PWM_WRAP_VALUE);
+        pwm_init(slice, &config, false);
+        m->slice_mask |= 1u << slice;
+    }
+    gpio_set_function(gpio, GPIO_FUNC_PWM);
+
+    // Começa parado no meio da faixa
+    int idx = (int)m->count++;
+    servo_manager_set_pulse(m, (uint)idx, (uint16_t)((min_us + max_us) / 2));
+    return idx;
+}
+
+void servo_manager_start(servo_manager_t *m) {
+    servo_manager_apply(m);
+    pwm_set_mask_enabled(pwm_hw->en | m->slice_mask);
+}
+
+void servo_manager_set_pulse(servo_manager_t *m, uint idx, uint16_t pulse_us) {
+    const servo_t *s = &m->servos[idx];
+    uint shift = s->channel == PWM_CHAN_B ? 16 : 0;
+
+    if (pulse_us < s->min_us) pulse_us = s->min_us;
+    if (pulse_us > s->max_us) pulse_us = s->max_us;
+
+    uint32_t cc = (m->cc[s->slice] & ~(0xFFFFu << shift)) | ((uint32_t)pulse_us << shift);
+    if (cc != m->cc[s->slice]) {
+        m->cc[s->slice] = cc;
+        m->dirty_mask |= 1u << s->slice;
+    }
+}
+
+void servo_manager_set_angle(servo_manager_t *m, uint idx, int32_t angle_ddeg) {
+    const servo_t *s = &m->servos[idx];
+
+    if (angle_ddeg < 0) angle_ddeg = 0;
+    if (angle_ddeg > 1800) angle_ddeg = 1800;
+
+    // Multiplicação e deslocamento no lugar da divisão em float
+    uint32_t offset = ((uint32_t)angle_ddeg * s->us_per_ddeg_q16 + (1u << 15)) >> 16;
+    servo_manager_set_pulse(m, idx, (uint16_t)(s->min_us + offset));
+}
+
+void servo_manager_apply(servo_manager_t *m) {
+    uint32_t dirty = m->dirty_mask;
+
+    if (dirty == 0) {
+        return;
+    }
+
+    // Todos os slices estão em fase: basta olhar o contador de um deles
+    uint ref = (uint)__builtin_ctz(m->slice_mask);
+    while (pwm_get_counter(ref) > PWM_WRAP_VALUE - SERVO_APPLY_MARGIN_US) {
+        tight_loop_contents();
+    }
+
+    for (uint slice = 0; dirty != 0; slice++, dirty >>= 1) {
+        if (dirty & 1u) {
+            pwm_set_both_levels(slice, (uint16_t)m->cc[slice], (uint16_t)(m->cc[slice] >> 16));
+        }
+    }
+    m->dirty_mask = 0;
+}
+
+// --- Perfis de movimento ---
+
+static servo_manager_t *servo_irq_manager;
+
+static uint16_t servo_manager_get_pulse(const servo_manager_t *m, uint idx) {
+    const servo_t *s = &m->servos[idx];
+    return (uint16_t)(m->cc[s->slice] >> (s->channel == PWM_CHAN_B ? 16 : 0));
+}
+
+// Limite por segundo convertido para 1/256 us por quadro^n (no mínimo 1)
+static int32_t servo_per_frame_q8(uint32_t per_s, uint32_t frames_per_s_n) {
+    uint64_t q8 = ((uint64_t)per_s << 8) / frames_per_s_n;
+    return q8 > 0 ? (int32_t)(q8 < INT32_MAX ? q8 : INT32_MAX) : 1;
+}
+
+void servo_manager_set_limits(servo_manager_t *m, uint idx, const servo_limits_t *limits) {
+    servo_motion_t *mo = &m->motion[idx];
+    int32_t pos = (int32_t)servo_manager_get_pulse(m, idx) << 8;
+
+    mo->enabled = false;
+    mo->vel_max_q8 = servo_per_frame_q8(limits->vel_max_us_s, SERVO_FRAME_HZ);
+    mo->acc_max_q8 = servo_per_frame_q8(limits->acc_max_us_s2, SERVO_FRAME_HZ * SERVO_FRAME_HZ);
+    mo->pos_q8 = pos;
+    mo->out_q8 = pos;
+    mo->target_q8 = pos;
+    mo->vel_q8 = 0;
+
+    // Janela da curva S: tempo (em quadros) para a aceleração ir de -máximo
+    // a +máximo com o jerk dado
+    mo->hist_len = 1;
+    if (limits->profile == SERVO_PROFILE_S_CURVE && limits->jerk_max_us_s3 > 0) {
+        uint32_t n = (2u * limits->acc_max_us_s2 * SERVO_FRAME_HZ + limits->jerk_max_us_s3 - 1) /
+                     limits->jerk_max_us_s3;
+        mo->hist_len = n < 1 ? 1 : n > SERVO_S_CURVE_MAX_FRAMES ? SERVO_S_CURVE_MAX_FRAMES : n;
+    }
+    for (uint i = 0; i < mo->hist_len; i++) {
+        mo->hist[i] = pos;
+    }
+    mo->hist_idx = 0;
+    mo->hist_sum = pos * (int32_t)mo->hist_len;
+    mo->enabled = true;
+}
+
+void servo_manager_move_to(servo_manager_t *m, uint idx, uint16_t pulse_us) {
+    const servo_t *s = &m->servos[idx];
+
+    if (pulse_us < s->min_us) pulse_us = s->min_us;
+    if (pulse_us > s->max_us) pulse_us = s->max_us;
+
+    // Escrita única de 32 bits: segura contra a interrupção de quadro
+    m->motion[idx].target_q8 = (int32_t)pulse_us << 8;
+}
+
+void servo_manager_move_to_angle(servo_manager_t *m, uint idx, int32_t angle_ddeg) {
+    const servo_t *s = &m->servos[idx];
+
+    if (angle_ddeg < 0) angle_ddeg = 0;
+    if (angle_ddeg > 1800) angle_ddeg = 1800;
+
+    uint32_t offset = ((uint32_t)angle_ddeg * s->us_per_ddeg_q16 + (1u << 15)) >> 16;
+    servo_manager_move_to(m, idx, (uint16_t)(s->min_us + offset));
+}
+
+bool servo_manager_is_moving(const servo_manager_t *m, uint idx) {
+    const servo_motion_t *mo = &m->motion[idx];
+    return mo->enabled && (mo->out_q8 != mo->target_q8 || mo->pos_q8 != mo->target_q8);
+}
+
+static inline int32_t servo_abs(int32_t x) {
+    return x < 0 ? -x : x;
+}
+
+// Raiz quadrada inteira (bit a bit)
+static uint32_t servo_isqrt(uint64_t x) {
+    uint64_t r = 0;
+    uint64_t bit = 1ull << 62;
+
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= r + bit) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)r;
+}
+
+// Maior velocidade por quadro que ainda para exatamente em d freando de a
+// em a. A partir de v, os passos v, v - a, ..., v - n*a (n = v / a) somam
+// (n + 1) * v - a * n * (n + 1) / 2: n é o maior inteiro com
+// a * n * (n + 1) / 2 <= d e o último passo fica abaixo de a.
+static int64_t servo_brake_velocity(int64_t d, int64_t a) {
+    int64_t n = ((int64_t)servo_isqrt((uint64_t)(8 * d / a + 1)) - 1) / 2;
+
+    while (a * (n + 1) * (n + 2) / 2 <= d) n++;
+    while (n > 0 && a * n * (n + 1) / 2 > d) n--;
+    return (d + a * n * (n + 1) / 2) / (n + 1);
+}
+
+// Um quadro do trapézio. A velocidade segue a maior velocidade que ainda
+// permite parar no alvo com a aceleração máxima, limitada por vel_max.
+static void servo_motion_step(servo_motion_t *mo) {
+    int32_t target = mo->target_q8;
+    int32_t err = target - mo->pos_q8;
+    int64_t a = mo->acc_max_q8;
+
+    if (err == 0 && mo->vel_q8 == 0) {
+        return;
+    }
+
+    int64_t d = servo_abs(err);
+    int64_t v_allow = servo_brake_velocity(d, a);
+    if (v_allow > mo->vel_max_q8) v_allow = mo->vel_max_q8;
+    int32_t v_des = (int32_t)(err > 0 ? v_allow : -v_allow);
+
+    int32_t acc = v_des - mo->vel_q8;
+    if (acc > a) acc = (int32_t)a;
+    if (acc < -a) acc = (int32_t)-a;
+
+    int32_t v = mo->vel_q8 + acc;
+    int32_t next = mo->pos_q8 + v;
+
+    // Chegada: o passo alcança (ou passa) o alvo com velocidade residual,
+    // que o último passo da frenagem deixa abaixo de a
+    if ((int64_t)(target - next) * err <= 0 && servo_abs(v) <= 2 * a) {
+        mo->pos_q8 = target;
+        mo->vel_q8 = 0;
+        return;
+    }
+    mo->pos_q8 = next;
+    mo->vel_q8 = v;
+}
+
+// Curva S: média móvel de n quadros da posição do trapézio. Equivale a
+// filtrar a velocidade por uma janela retangular, o que transforma cada
+// degrau de aceleração em uma rampa de n quadros, sem ultrapassar o alvo e
+// terminando exatamente nele. O maior degrau é de +a para -a (movimento
+// curto ou alvo invertido), por isso n cobre 2a / jerk_max.
+static int32_t servo_motion_smooth(servo_motion_t *mo) {
+    if (mo->hist_len <= 1) {
+        return mo->pos_q8;
+    }
+
+    mo->hist_sum += mo->pos_q8 - mo->hist[mo->hist_idx];
+    mo->hist[mo->hist_idx] = mo->pos_q8;
+    if (++mo->hist_idx == mo->hist_len) {
+        mo->hist_idx = 0;
+    }
+    return mo->hist_sum / (int32_t)mo->hist_len;
+}
+
+void servo_manager_step(servo_manager_t *m) {
+    for (uint i = 0; i < m->count; i++) {
+        servo_motion_t *mo = &m->motion[i];
+        if (!mo->enabled) {
+            continue;
+        }
+        servo_motion_step(mo);
+        mo->out_q8 = servo_motion_smooth(mo);
+        servo_manager_set_pulse(m, i, (uint16_t)((mo->out_q8 + 128) >> 8));
+    }
+    servo_manager_apply(m);
+}
+
+static void servo_frame_irq(void) {
+    servo_manager_t *m = servo_irq_manager;
+    uint ref = (uint)__builtin_ctz(m->slice_mask);
+
+    pwm_clear_irq(ref);
+    servo_manager_step(m);
+}
+
+void servo_manager_enable_frame_irq(servo_manager_t *m) {
+    // Todos os slices estão em fase: o wrap do primeiro marca o quadro
+    uint ref = (uint)__builtin_ctz(m->slice_mask);
+
+    servo_irq_manager = m;
+    pwm_clear_irq(ref);
+    pwm_set_irq_enabled(ref, true);
+    irq_set_exclusive_handler(PWM_IRQ_WRAP, servo_frame_irq);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
+}
@@ -37,4 +37,175 @@ void servo_set_angle(uint gpio_pin, float angle);
  */
 void servo_set_pulse_width(uint gpio_pin, uint32_t pulse_width_us);
 
+// --- Gerenciador de vários servos ---
+
+/** Servos por gerenciador: 8 slices com 2 canais cada. */
+#define SERVO_MAX_SERVOS 16
+
+/** Slices de PWM do RP2040. */
+#define SERVO_NUM_SLICES 8
+
+/**
+ * @brief Servo registrado no gerenciador.
+ *
+ * Slice, canal e o fator de conversão de ângulo são calculados uma única
+ * vez no registro.
+ */
+typedef struct {
+    uint gpio;
+    uint slice;
+    uint channel;
+    uint16_t min_us;
+    uint16_t max_us;
+    uint32_t us_per_ddeg_q16;   // (max - min) / 1800 em Q16: ângulo em décimos de grau
+} servo_t;
+
+/** Quadros de PWM por segundo: o perfil de movimento avança um passo por quadro. */
+#define SERVO_FRAME_HZ 50
+
+/** Maior janela da curva S, em quadros (320 ms). */
+#define SERVO_S_CURVE_MAX_FRAMES 16
+
+/**
+ * @brief Forma do perfil de movimento.
+ *
+ * No trapézio a aceleração salta entre 0 e o máximo; na curva S ela varia
+ * no máximo jerk_max por segundo, suavizando o início e o fim do movimento.
+ * A rampa cobre a troca de -acc_max para +acc_max em 2 * acc_max /
+ * jerk_max, limitada a SERVO_S_CURVE_MAX_FRAMES quadros (acima disso o
+ * jerk passa do limite).
+ */
+typedef enum {
+    SERVO_PROFILE_TRAPEZOID,
+    SERVO_PROFILE_S_CURVE,
+} servo_profile_t;
+
+/**
+ * @brief Limites do movimento, em unidades de largura de pulso.
+ */
+typedef struct {
+    servo_profile_t profile;
+    uint32_t vel_max_us_s;      // us/s
+    uint32_t acc_max_us_s2;     // us/s^2
+    uint32_t jerk_max_us_s3;    // us/s^3, só na curva S
+} servo_limits_t;
+
+/**
+ * @brief Estado do perfil de um servo, em 1/256 us e por quadro.
+ */
+typedef struct {
+    bool enabled;
+    volatile int32_t target_q8;
+    int32_t pos_q8;             // posição do trapézio
+    int32_t vel_q8;             // por quadro
+    int32_t out_q8;             // posição enviada ao servo (suavizada na curva S)
+    int32_t vel_max_q8;
+    int32_t acc_max_q8;         // por quadro^2
+
+    // Curva S: média móvel das últimas hist_len posições do trapézio
+    int32_t hist[SERVO_S_CURVE_MAX_FRAMES];
+    int32_t hist_sum;
+    uint8_t hist_len;
+    uint8_t hist_idx;
+} servo_motion_t;
+
+/**
+ * @brief Conjunto de servos atualizados juntos.
+ *
+ * Os comandos ficam em uma cópia dos registradores CC de cada slice (os dois
+ * canais em uma palavra de 32 bits) e vão para o hardware em
+ * servo_manager_apply, uma escrita por slice.
+ */
+typedef struct {
+    servo_t servos[SERVO_MAX_SERVOS];
+    uint count;
+    uint32_t slice_mask;                // slices com algum servo
+    uint32_t cc[SERVO_NUM_SLICES];      // nível do canal A nos bits 15..0, B nos 31..16
+    uint32_t dirty_mask;                // slices com nível alterado desde o último apply
+    servo_motion_t motion[SERVO_MAX_SERVOS];
+} servo_manager_t;
+
+/**
+ * @brief Prepara um gerenciador vazio.
+ */
+void servo_manager_init(servo_manager_t *m);
+
+/**
+ * @brief Registra um servo e configura o PWM do seu pino (50 Hz, 1 us por contagem).
+ *
+ * O slice só começa a contar em servo_manager_start, junto com os demais.
+ *
+ * @param gpio Pino do servo.
+ * @param min_us Largura de pulso em 0 graus.
+ * @param max_us Largura de pulso em 180 graus.
+ * @return Índice do servo, ou -1 se não houver espaço ou o canal já estiver em uso.
+ */
+int servo_manager_add(servo_manager_t *m, uint gpio, uint16_t min_us, uint16_t max_us);
+
+/**
+ * @brief Liga todos os slices usados ao mesmo tempo, com os contadores em fase.
+ *
+ * Com os slices em fase, as escritas de um apply valem todas no mesmo wrap.
+ */
+void servo_manager_start(servo_manager_t *m);
+
+/**
+ * @brief Define a largura de pulso de um servo (só na cópia local).
+ */
+void servo_manager_set_pulse(servo_manager_t *m, uint idx, uint16_t pulse_us);
+
+/**
+ * @brief Define o ângulo de um servo em décimos de grau (0 a 1800), sem float.
+ */
+void servo_manager_set_angle(servo_manager_t *m, uint idx, int32_t angle_ddeg);
+
+/**
+ * @brief Envia os níveis alterados ao hardware.
+ *
+ * Os registradores CC têm buffer duplo e só são carregados no wrap do
+ * contador. Se o wrap estiver próximo, espera ele passar, para que todas as
+ * escritas caiam no mesmo período e os servos mudem juntos.
+ */
+void servo_manager_apply(servo_manager_t *m);
+
+// --- Perfis de movimento ---
+
+/**
+ * @brief Liga o perfil de movimento de um servo, partindo do pulso atual.
+ *
+ * Depois disso o servo segue o alvo de servo_manager_move_to respeitando
+ * os limites de velocidade, aceleração e (na curva S) jerk.
+ */
+void servo_manager_set_limits(servo_manager_t *m, uint idx, const servo_limits_t *limits);
+
+/**
+ * @brief Define o alvo de um servo com perfil (pode ser trocado a qualquer momento).
+ */
+void servo_manager_move_to(servo_manager_t *m, uint idx, uint16_t pulse_us);
+
+/**
+ * @brief Alvo em décimos de grau (0 a 1800).
+ */
+void servo_manager_move_to_angle(servo_manager_t *m, uint idx, int32_t angle_ddeg);
+
+/**
+ * @brief Indica se o servo ainda não chegou ao alvo.
+ */
+bool servo_manager_is_moving(const servo_manager_t *m, uint idx);
+
+/**
+ * @brief Avança os perfis de um quadro (1 / SERVO_FRAME_HZ) e aplica os pulsos.
+ */
+void servo_manager_step(servo_manager_t *m);
+
+/**
+ * @brief Chama servo_manager_step na interrupção de wrap do PWM.
+ *
+ * Os pulsos calculados em um quadro valem a partir do wrap seguinte, sem
+ * depender do laço principal. Só um gerenciador pode usar a interrupção.
+ * Com ela ligada, todos os servos devem ter perfil (servo_manager_set_limits):
+ * set_pulse/apply no laço principal disputariam a cópia dos registradores.
+ */
+void servo_manager_enable_frame_irq(servo_manager_t *m);
+
 #endif // SERVO_H
\ No newline at end of file
@@ -2,11 +2,14 @@
 #include <math.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 
 // Inclui as bibliotecas em C dentro de um bloco 'extern "C"'
 extern "C" {
 #include "servo.h"
 #include "ssd1306.h"
+#include "orientation.h"
+#include "pid.h"
 }
 
 // Inclui a biblioteca do MPU6050 em C++.
@@ -28,7 +31,42 @@ extern "C" {
 #define I2C0_SCL_PIN 1
 #define MPU6050_ADDR 0x68
 
-const float ACCEL_SCALE_FACTOR = 16384.0f;
+// +/- 2 g, +/- 500 graus/s, DLPF de 44 Hz e 1 kHz / (1 + 1) = 500 Hz,
+// casando com o período de amostragem
+static constexpr MPU6050::Config MPU_CONFIG = {
+    MPU6050::AccelRange::G2,
+    MPU6050::GyroRange::DPS500,
+    MPU6050::Dlpf::HZ44,
+    1,
+    0,
+    0,
+};
+
+// --- Configuração do controle ---
+// Leitura do sensor, filtro de orientação e PID rodam em um timer repetitivo
+// de hardware; o laço principal só cuida de printf e display. O filtro
+// integra o giroscópio a cada amostra (500 Hz); o PID roda a cada
+// PID_A_CADA chamadas (250 Hz), bem acima do quadro de 50 Hz do servo
+#define CONTROLE_PERIODO_US 2000        // 500 Hz
+static_assert(MPU_CONFIG.sampleRateHz() == 1000000 / CONTROLE_PERIODO_US, "taxa do sensor diferente da do controle");
+#define PID_A_CADA 2
+#define PID_PERIODO_US (CONTROLE_PERIODO_US * PID_A_CADA)
+#define SAIDA_PERIODO_MS 100            // printf e display
+#define JITTER_A_CADA 10                // relatório de jitter a cada 10 saídas (1 s)
+#define CALIBRACAO_AMOSTRAS 250         // 0,5 s parado para medir o offset do giroscópio
+
+// PID do pitch (em centésimos de grau) para o pulso do servo (us a partir do
+// ponto de parada). Kp = 1000 us / 90 graus, como o mapeamento anterior.
+// Sem integral: o servo de rotação contínua já integra (o pulso é
+// velocidade), e um integral acumulado o manteria girando dentro da zona
+// morta, com a plataforma nivelada. Lá a saída volta ao pulso de parada.
+#define PID_KP PID_GAIN(0.111)          // us por centésimo de grau
+#define PID_KI 0                        // us por centésimo de grau por segundo
+#define PID_KD PID_GAIN(0.002)          // us por (centésimo de grau por segundo)
+
+// Descomente para imprimir as amostras brutas em CSV (t_us,ax,ay,az,gx,gy,gz),
+// no formato lido por tools/orientation_bench
+// #define ORIENTATION_TRACE
 
 // --- Configuração do Servo ---
 #define SERVO_PIN 2
@@ -43,8 +81,86 @@ const float ANGLE_ALERT_THRESHOLD = 45.0f;
 #define SERVO_MAX_PULSE_US 2500
 #define SERVO_DEAD_ZONE_DEGREES 5.0f
 
-float map_value(float value, float fromLow, float fromHigh, float toLow, float toHigh) {
-    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+// Perfil do comando do servo (pulso em us): a velocidade de rotação muda
+// em rampa em S, a cada quadro de PWM, em vez de saltar a cada 100 ms
+#define SERVO_VEL_MAX_US_S 4000
+#define SERVO_ACEL_MAX_US_S2 20000
+#define SERVO_JERK_MAX_US_S3 200000
+
+#ifdef ORIENTATION_TRACE
+// Amostras do timer para o laço principal imprimir
+#define TRACE_TAMANHO 64
+static MPU6050::Sample trace[TRACE_TAMANHO];
+static volatile uint32_t trace_escrita = 0;
+static uint32_t trace_leitura = 0;
+#endif
+
+// Estado compartilhado entre o timer de controle e o laço principal
+struct Controle {
+    MPU6050 *mpu;
+    orientation_t orientation;
+    pid_controller_t pid;
+    servo_manager_t *servos;
+    uint servo;
+    uint64_t ultima_amostra_us;
+    uint32_t amostras_pid;              // amostras desde o último passo do PID
+
+    // Saídas para exibição
+    volatile int32_t pitch;             // Q16 graus
+    volatile uint32_t pulso_us;
+
+    // Temporização: desvio do início de cada chamada em relação ao período
+    // e tempo de execução, zerados a cada relatório
+    uint64_t ultimo_inicio_us;
+    volatile uint32_t jitter_max_us;
+    volatile uint64_t jitter_soma_us;
+    volatile uint32_t execucao_max_us;
+    volatile uint32_t chamadas;
+    volatile uint32_t atrasos;          // chamadas com mais de meio período de atraso
+};
+
+static bool controle_callback(repeating_timer_t *rt) {
+    Controle *c = (Controle *)rt->user_data;
+    uint64_t inicio = time_us_64();
+
+    if (c->ultimo_inicio_us != 0) {
+        int32_t desvio = (int32_t)(inicio - c->ultimo_inicio_us) - CONTROLE_PERIODO_US;
+        uint32_t jitter = (uint32_t)(desvio < 0 ? -desvio : desvio);
+        if (jitter > c->jitter_max_us) c->jitter_max_us = jitter;
+        c->jitter_soma_us += jitter;
+        if (desvio > CONTROLE_PERIODO_US / 2) c->atrasos++;
+    }
+    c->ultimo_inicio_us = inicio;
+
+    MPU6050::Sample sample;
+    if (c->mpu->read(sample)) {
+        // dt medido pelo timestamp da leitura, não pelo período nominal
+        uint32_t dt_us = c->ultima_amostra_us ? (uint32_t)(sample.timestamp_us - c->ultima_amostra_us) : 0;
+        c->ultima_amostra_us = sample.timestamp_us;
+        orientation_update(&c->orientation, sample.accel_raw, sample.gyro_raw, dt_us);
+
+#ifdef ORIENTATION_TRACE
+        trace[trace_escrita % TRACE_TAMANHO] = sample;
+        trace_escrita = trace_escrita + 1;
+#endif
+    }
+
+    // Pitch em centésimos de grau; setpoint 0 (plataforma nivelada)
+    int32_t pitch = c->orientation.pitch;
+    c->pitch = pitch;
+    if (++c->amostras_pid >= PID_A_CADA) {
+        c->amostras_pid = 0;
+        int32_t pitch_cdeg = (int32_t)(((int64_t)pitch * 100) / ORIENTATION_Q16_ONE);
+        int32_t saida = pid_update(&c->pid, 0, pitch_cdeg);
+        uint32_t pulso = (uint32_t)(SERVO_STOP_PULSE_US + saida);
+        servo_manager_move_to(c->servos, c->servo, (uint16_t)pulso);
+        c->pulso_us = pulso;
+    }
+
+    uint32_t execucao = (uint32_t)(time_us_64() - inicio);
+    if (execucao > c->execucao_max_us) c->execucao_max_us = execucao;
+    c->chamadas = c->chamadas + 1;
+    return true;
 }
 
 // --- Função Principal ---
@@ -72,11 +188,20 @@ int main() {
 
     // Inicializa o MPU6050 na porta I2C0
     MPU6050 mpu(I2C0_PORT, MPU6050_ADDR);
-    mpu.begin();
+    mpu.begin(MPU_CONFIG);
     printf("MPU6050 inicializado. ID: 0x%X\n", mpu.getId());
     
-    // Inicializa o Servo no novo pino
-    servo_init(SERVO_PIN);
+    // Inicializa o Servo no novo pino (slice e canal calculados uma vez)
+    static servo_manager_t servos;
+    servo_manager_init(&servos);
+    int servo = servo_manager_add(&servos, SERVO_PIN, SERVO_MIN_PULSE_US, SERVO_MAX_PULSE_US);
+    servo_manager_start(&servos);
+
+    const servo_limits_t limites = {
+        SERVO_PROFILE_S_CURVE, SERVO_VEL_MAX_US_S, SERVO_ACEL_MAX_US_S2, SERVO_JERK_MAX_US_S3
+    };
+    servo_manager_set_limits(&servos, (uint)servo, &limites);
+    servo_manager_enable_frame_irq(&servos);
     printf("Servo motor inicializado no pino GPIO%d.\n", SERVO_PIN);
 
     // Inicializa o Display OLED na porta I2C1
@@ -85,28 +210,97 @@ int main() {
     ssd1306_init(&disp, OLED_WIDTH, OLED_HEIGHT, OLED_ADDR, I2C1_PORT);
     printf("Display OLED SSD1306 inicializado.\n");
     
-    MPU6050::VECT_3D accel;
-    float pitch;
-    uint32_t pulse_width_us;
+    // Filtro complementar em ponto fixo, com as escalas da configuração do sensor
+    orientation_config_t orientation_cfg;
+    orientation_cfg.accel_lsb_per_g = MPU_CONFIG.accelLsbPerG();
+    orientation_cfg.gyro_lsb_per_dps_x10 = MPU_CONFIG.gyroLsbPerDpsX10();
+    orientation_cfg.tau_ms = 500;
+    orientation_cfg.accel_gate_pct = 15;
+    orientation_t orientation;
+    orientation_init(&orientation, &orientation_cfg);
 
-    while (1) {
-        mpu.getAccel(&accel, ACCEL_SCALE_FACTOR);
-        pitch = atan2(-accel.x, sqrt(accel.y * accel.y + accel.z * accel.z)) * 180.0 / M_PI;
-        
-        printf("Angulo (Pitch): %.2f graus | ", pitch);
+    MPU6050::Sample sample;
 
-        if (fabs(pitch) < SERVO_DEAD_ZONE_DEGREES) {
-            pulse_width_us = SERVO_STOP_PULSE_US;
-        } else {
-            pulse_width_us = (uint32_t)map_value(pitch, -90.0f, 90.0f, 
-                                                  SERVO_MAX_PULSE_US, SERVO_MIN_PULSE_US);
+    // Offset do giroscópio com o sensor parado
+    int32_t gyro_sum[3] = { 0, 0, 0 };
+    int calibradas = 0;
+    for (int i = 0; i < CALIBRACAO_AMOSTRAS; i++) {
+        if (mpu.read(sample)) {
+            for (int k = 0; k < 3; k++) gyro_sum[k] += sample.gyro_raw[k];
+            calibradas++;
+        }
+        sleep_us(CONTROLE_PERIODO_US);
+    }
+    if (calibradas > 0) {
+        int32_t bias[3] = { gyro_sum[0] / calibradas, gyro_sum[1] / calibradas, gyro_sum[2] / calibradas };
+        orientation_set_gyro_bias(&orientation, bias);
+        printf("Offset do giroscopio: %ld %ld %ld\n", (long)bias[0], (long)bias[1], (long)bias[2]);
+    }
+
+    static Controle controle;
+    controle.mpu = &mpu;
+    controle.orientation = orientation;
+    controle.servos = &servos;
+    controle.servo = (uint)servo;
+
+    pid_config_t pid_cfg;
+    pid_cfg.kp = PID_KP;
+    pid_cfg.ki = PID_KI;
+    pid_cfg.kd = PID_KD;
+    pid_cfg.period_us = PID_PERIODO_US;
+    pid_cfg.out_min = SERVO_MIN_PULSE_US - SERVO_STOP_PULSE_US;
+    pid_cfg.out_max = SERVO_MAX_PULSE_US - SERVO_STOP_PULSE_US;
+    pid_cfg.deadband = (int32_t)(SERVO_DEAD_ZONE_DEGREES * 100);
+    pid_init(&controle.pid, &pid_cfg);
 
-            if (pulse_width_us < SERVO_MIN_PULSE_US) pulse_width_us = SERVO_MIN_PULSE_US;
-            if (pulse_width_us > SERVO_MAX_PULSE_US) pulse_width_us = SERVO_MAX_PULSE_US;
+    // Período negativo: intervalo entre inícios, independente da duração
+    repeating_timer_t timer;
+    add_repeating_timer_us(-CONTROLE_PERIODO_US, controle_callback, &controle, &timer);
+
+#ifndef ORIENTATION_TRACE
+    uint32_t saidas = 0;
+#endif
+    absolute_time_t proxima = get_absolute_time();
+
+    while (1) {
+        proxima = delayed_by_ms(proxima, SAIDA_PERIODO_MS);
+
+#ifdef ORIENTATION_TRACE
+        while (trace_leitura != trace_escrita) {
+            const MPU6050::Sample &t = trace[trace_leitura % TRACE_TAMANHO];
+            printf("%llu,%d,%d,%d,%d,%d,%d\n", (unsigned long long)t.timestamp_us,
+                   t.accel_raw[0], t.accel_raw[1], t.accel_raw[2],
+                   t.gyro_raw[0], t.gyro_raw[1], t.gyro_raw[2]);
+            trace_leitura++;
         }
+#endif
 
-        servo_set_pulse_width(SERVO_PIN, pulse_width_us);
-        printf("Largura do Pulso: %u us\n", pulse_width_us);
+        float pitch = orientation_to_deg(controle.pitch);
+        uint32_t pulse_width_us = controle.pulso_us;
+
+#ifndef ORIENTATION_TRACE
+        printf("Angulo (Pitch): %.2f graus | Largura do Pulso: %u us\n", pitch, pulse_width_us);
+
+        if (++saidas % JITTER_A_CADA == 0) {
+            uint32_t irq = save_and_disable_interrupts();
+            uint32_t chamadas = controle.chamadas;
+            uint32_t jitter_max = controle.jitter_max_us;
+            uint64_t jitter_soma = controle.jitter_soma_us;
+            uint32_t execucao_max = controle.execucao_max_us;
+            uint32_t atrasos = controle.atrasos;
+            controle.chamadas = 0;
+            controle.jitter_max_us = 0;
+            controle.jitter_soma_us = 0;
+            controle.execucao_max_us = 0;
+            controle.atrasos = 0;
+            restore_interrupts(irq);
+
+            printf("Controle: %lu chamadas, jitter max %lu us (medio %lu us), execucao max %lu us, atrasos %lu\n",
+                   (unsigned long)chamadas, (unsigned long)jitter_max,
+                   (unsigned long)(chamadas ? jitter_soma / chamadas : 0),
+                   (unsigned long)execucao_max, (unsigned long)atrasos);
+        }
+#endif
 
         ssd1306_clear(&disp);
         char display_buffer[20];
@@ -121,7 +315,7 @@ int main() {
         }
         ssd1306_show(&disp);
 
-        sleep_ms(100);
+        sleep_until(proxima);
     }
 
     return 0;
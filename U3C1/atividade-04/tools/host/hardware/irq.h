@@ -0,0 +1,15 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+// Sem interrupções no host: quem testa chama servo_manager_step por quadro
+
+#include "pico/stdlib.h"
+
+#define PWM_IRQ_WRAP 4
+
+typedef void (*irq_handler_t)(void);
+
+static inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) { (void)num; (void)handler; }
+static inline void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
+
+#endif
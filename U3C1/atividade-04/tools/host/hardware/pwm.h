@@ -0,0 +1,57 @@
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+// PWM do host: os níveis escritos ficam em pwm_host_level para a
+// verificação ler o pulso que iria para o servo. O contador fica sempre no
+// início do período (o apply nunca espera o wrap).
+
+#include "pico/stdlib.h"
+
+#define NUM_PWM_SLICES 8
+#define PWM_CHAN_A 0
+#define PWM_CHAN_B 1
+
+typedef struct {
+    float clkdiv;
+    uint16_t wrap;
+} pwm_config;
+
+typedef struct {
+    uint32_t en;
+} pwm_hw_t;
+
+extern pwm_hw_t *pwm_hw;
+extern uint16_t pwm_host_level[NUM_PWM_SLICES][2];
+
+static inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1u) & 7u; }
+static inline uint pwm_gpio_to_channel(uint gpio) { return gpio & 1u; }
+
+static inline pwm_config pwm_get_default_config(void) {
+    pwm_config c = { 1.0f, 0xFFFF };
+    return c;
+}
+static inline void pwm_config_set_clkdiv(pwm_config *c, float div) { c->clkdiv = div; }
+static inline void pwm_config_set_wrap(pwm_config *c, uint16_t wrap) { c->wrap = wrap; }
+
+static inline void pwm_init(uint slice, pwm_config *c, bool start) {
+    (void)c;
+    if (start) pwm_hw->en |= 1u << slice;
+}
+static inline void pwm_set_mask_enabled(uint32_t mask) { pwm_hw->en = mask; }
+
+static inline void pwm_set_chan_level(uint slice, uint chan, uint16_t level) {
+    pwm_host_level[slice][chan] = level;
+}
+static inline void pwm_set_both_levels(uint slice, uint16_t a, uint16_t b) {
+    pwm_host_level[slice][PWM_CHAN_A] = a;
+    pwm_host_level[slice][PWM_CHAN_B] = b;
+}
+static inline uint16_t pwm_get_counter(uint slice) {
+    (void)slice;
+    return 0;
+}
+
+static inline void pwm_clear_irq(uint slice) { (void)slice; }
+static inline void pwm_set_irq_enabled(uint slice, bool enabled) { (void)slice; (void)enabled; }
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Substituto mínimo do pico/stdlib.h para compilar lib/servo no Linux.
+// Só o que o gerenciador de servos usa é fornecido aqui.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+enum gpio_function {
+    GPIO_FUNC_PWM = 4,
+};
+
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void tight_loop_contents(void) {}
+
+#endif
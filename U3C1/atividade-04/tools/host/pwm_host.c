@@ -0,0 +1,6 @@
+#include "hardware/pwm.h"
+
+static pwm_hw_t pwm_host_hw;
+pwm_hw_t *pwm_hw = &pwm_host_hw;
+
+uint16_t pwm_host_level[NUM_PWM_SLICES][2];
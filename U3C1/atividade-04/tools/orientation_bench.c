@@ -0,0 +1,312 @@
+// Bancada do filtro de orientação no host.
+//
+// Reproduz um trace de amostras brutas do MPU6050 (ou gera um sintético com
+// movimento conhecido, ruído e offset de giroscópio), roda o filtro em ponto
+// fixo e uma referência em double com o mesmo algoritmo, e mede precisão e
+// custo por atualização. Sai com erro se o atan2 em ponto fixo ou o filtro
+// em ponto fixo se afastarem do double mais que os limites abaixo.
+//
+// Uso: orientation_bench [--trace arquivo.csv] [--iter N]
+//
+// Formato do trace (gerado pelo main com ORIENTATION_TRACE):
+//   t_us,ax,ay,az,gx,gy,gz
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "orientation.h"
+
+#define ACCEL_LSB_PER_G 16384
+#define GYRO_LSB_PER_DPS 65.5
+#define TAU_MS 500
+#define SYNTH_RATE_HZ 500
+#define SYNTH_SECONDS 60
+
+// Erro máximo aceito contra o double, em graus: o atan2 em ponto fixo e o
+// pitch/roll do filtro (depois da convergência)
+#define ATAN2_ERRO_MAX_GRAUS 0.1
+#define FILTRO_ERRO_MAX_GRAUS 0.1
+
+typedef struct {
+    uint64_t t_us;
+    int16_t accel[3];
+    int16_t gyro[3];
+    bool has_truth;
+    double pitch, roll;     // verdade (só no trace sintético)
+} trace_sample_t;
+
+static const orientation_config_t config = {
+    .accel_lsb_per_g = ACCEL_LSB_PER_G,
+    .gyro_lsb_per_dps_x10 = 655,
+    .tau_ms = TAU_MS,
+    .accel_gate_pct = 15,
+};
+
+//=========================================================
+//               Referência em double
+//=========================================================
+
+typedef struct {
+    double pitch, roll, yaw;
+    bool initialized;
+} ref_filter_t;
+
+static double wrap_deg(double a) {
+    while (a > 180.0) a -= 360.0;
+    while (a < -180.0) a += 360.0;
+    return a;
+}
+
+static void ref_update(ref_filter_t *f, const int16_t a[3], const int16_t g[3], uint32_t dt_us) {
+    double ax = a[0], ay = a[1], az = a[2];
+    double pitch_acc = atan2(-ax, sqrt(ay * ay + az * az)) * 180.0 / M_PI;
+    double roll_acc = atan2(ay, az) * 180.0 / M_PI;
+
+    if (!f->initialized) {
+        f->pitch = pitch_acc;
+        f->roll = roll_acc;
+        f->yaw = 0;
+        f->initialized = true;
+        return;
+    }
+
+    double dt = dt_us * 1e-6;
+    f->roll = wrap_deg(f->roll + g[0] / GYRO_LSB_PER_DPS * dt);
+    f->pitch = wrap_deg(f->pitch + g[1] / GYRO_LSB_PER_DPS * dt);
+    f->yaw = wrap_deg(f->yaw + g[2] / GYRO_LSB_PER_DPS * dt);
+
+    double mag = sqrt(ax * ax + ay * ay + az * az) / ACCEL_LSB_PER_G;
+    if (mag >= 0.85 && mag <= 1.15) {
+        double k = dt / (TAU_MS * 1e-3 + dt);
+        f->pitch = wrap_deg(f->pitch + wrap_deg(pitch_acc - f->pitch) * k);
+        f->roll = wrap_deg(f->roll + wrap_deg(roll_acc - f->roll) * k);
+    }
+}
+
+//=========================================================
+//                 Traces de entrada
+//=========================================================
+
+static double gauss(void) {
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static int16_t sat16(double v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)lround(v);
+}
+
+// Sensor parado por 2 s (estimativa do offset) e depois oscilações de
+// pitch/roll com ruído, offset de giroscópio e alguns trancos
+static size_t synth_trace(trace_sample_t **out) {
+    const size_t n = SYNTH_RATE_HZ * SYNTH_SECONDS;
+    const double dt = 1.0 / SYNTH_RATE_HZ;
+    trace_sample_t *s = calloc(n, sizeof(*s));
+
+    srand(1234);
+    for (size_t i = 0; i < n; i++) {
+        double t = i * dt;
+        double m = t < 2.0 ? 0.0 : t - 2.0;
+        double on = t < 2.0 ? 0.0 : 1.0;
+        double th = 35.0 * sin(2 * M_PI * 0.4 * m) * M_PI / 180.0;
+        double ph = 25.0 * sin(2 * M_PI * 0.25 * m) * M_PI / 180.0;
+        double thd = on * 35.0 * 2 * M_PI * 0.4 * cos(2 * M_PI * 0.4 * m);
+        double phd = on * 25.0 * 2 * M_PI * 0.25 * cos(2 * M_PI * 0.25 * m);
+
+        double bump = (on && fmod(t, 7.0) < 0.05) ? 0.8 : 0.0;
+        double ax = -sin(th) + bump + 0.01 * gauss();
+        double ay = sin(ph) * cos(th) + 0.01 * gauss();
+        double az = cos(ph) * cos(th) + 0.01 * gauss();
+
+        s[i].t_us = (uint64_t)llround(t * 1e6);
+        s[i].accel[0] = sat16(ax * ACCEL_LSB_PER_G);
+        s[i].accel[1] = sat16(ay * ACCEL_LSB_PER_G);
+        s[i].accel[2] = sat16(az * ACCEL_LSB_PER_G);
+        s[i].gyro[0] = sat16((phd + 0.3 * gauss()) * GYRO_LSB_PER_DPS + 40);
+        s[i].gyro[1] = sat16((thd + 0.3 * gauss()) * GYRO_LSB_PER_DPS - 25);
+        s[i].gyro[2] = sat16(0.3 * gauss() * GYRO_LSB_PER_DPS + 10);
+        s[i].has_truth = true;
+        s[i].pitch = th * 180.0 / M_PI;
+        s[i].roll = ph * 180.0 / M_PI;
+    }
+
+    *out = s;
+    return n;
+}
+
+static size_t load_trace(const char *path, trace_sample_t **out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return 0;
+    }
+
+    size_t cap = 4096, n = 0;
+    trace_sample_t *s = malloc(cap * sizeof(*s));
+    char line[160];
+
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long long t;
+        int v[6];
+        if (sscanf(line, "%llu,%d,%d,%d,%d,%d,%d", &t, &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 7) {
+            continue;
+        }
+        if (n == cap) {
+            cap *= 2;
+            s = realloc(s, cap * sizeof(*s));
+        }
+        s[n].t_us = t;
+        for (int k = 0; k < 3; k++) {
+            s[n].accel[k] = (int16_t)v[k];
+            s[n].gyro[k] = (int16_t)v[3 + k];
+        }
+        s[n].has_truth = false;
+        n++;
+    }
+
+    fclose(f);
+    *out = s;
+    return n;
+}
+
+//=========================================================
+//                        main
+//=========================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// Offset do giroscópio: média do primeiro segundo, com o sensor parado
+static void estimate_bias(const trace_sample_t *s, size_t n, int32_t bias[3]) {
+    int64_t acc[3] = { 0, 0, 0 };
+    size_t m = 0;
+    for (size_t i = 0; i < n && s[i].t_us - s[0].t_us < 1000000; i++, m++)
+        for (int k = 0; k < 3; k++)
+            acc[k] += s[i].gyro[k];
+    for (int k = 0; k < 3; k++)
+        bias[k] = m ? (int32_t)(acc[k] / (int64_t)m) : 0;
+}
+
+int main(int argc, char **argv) {
+    const char *trace_path = NULL;
+    uint32_t iterations = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "uso: %s [--trace arquivo.csv] [--iter N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    trace_sample_t *s;
+    size_t n = trace_path ? load_trace(trace_path, &s) : synth_trace(&s);
+    if (n < 2) {
+        fprintf(stderr, "Trace vazio ou invalido\n");
+        return 1;
+    }
+    printf("%zu amostras (%s)\n", n, trace_path ? trace_path : "sintetico");
+
+    // Precisão do atan2 em ponto fixo
+    double atan_err = 0;
+    for (int a = 0; a < 36000; a++) {
+        double rad = (a / 100.0 - 180.0) * M_PI / 180.0;
+        int32_t y = (int32_t)lround(sin(rad) * 30000), x = (int32_t)lround(cos(rad) * 30000);
+        double e = fabs(wrap_deg(orientation_to_deg(orientation_atan2(y, x)) - atan2(y, x) * 180.0 / M_PI));
+        if (e > atan_err) atan_err = e;
+    }
+    printf("atan2 ponto fixo: erro maximo %.4f graus (limite %.2f)\n", atan_err, ATAN2_ERRO_MAX_GRAUS);
+
+    int32_t bias[3];
+    estimate_bias(s, n, bias);
+
+    // Precisão: ponto fixo x referência double x verdade
+    orientation_t o;
+    ref_filter_t ref = { 0 };
+    int16_t gyro_nb[3];
+    orientation_init(&o, &config);
+    orientation_set_gyro_bias(&o, bias);
+
+    double sq_fix_ref = 0, sq_fix_true = 0, sq_ref_true = 0, max_fix_ref = 0;
+    size_t counted = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t dt = i ? (uint32_t)(s[i].t_us - s[i - 1].t_us) : 0;
+        for (int k = 0; k < 3; k++)
+            gyro_nb[k] = (int16_t)(s[i].gyro[k] - bias[k]);
+
+        orientation_update(&o, s[i].accel, s[i].gyro, dt);
+        ref_update(&ref, s[i].accel, gyro_nb, dt);
+
+        // Ignora os primeiros 2 s (convergência)
+        if (s[i].t_us - s[0].t_us < 2000000) {
+            continue;
+        }
+
+        double dp = orientation_to_deg(o.pitch) - ref.pitch;
+        double dr = orientation_to_deg(o.roll) - ref.roll;
+        sq_fix_ref += dp * dp + dr * dr;
+        if (fabs(dp) > max_fix_ref) max_fix_ref = fabs(dp);
+        if (fabs(dr) > max_fix_ref) max_fix_ref = fabs(dr);
+
+        if (s[i].has_truth) {
+            double tp = orientation_to_deg(o.pitch) - s[i].pitch;
+            double tr = orientation_to_deg(o.roll) - s[i].roll;
+            double rp = ref.pitch - s[i].pitch;
+            double rr = ref.roll - s[i].roll;
+            sq_fix_true += tp * tp + tr * tr;
+            sq_ref_true += rp * rp + rr * rr;
+        }
+        counted++;
+    }
+
+    if (counted) {
+        printf("ponto fixo x double: RMS %.4f graus, max %.4f graus (limite %.2f)\n", sqrt(sq_fix_ref / (2 * counted)),
+               max_fix_ref, FILTRO_ERRO_MAX_GRAUS);
+        if (s[0].has_truth) {
+            printf("erro contra a verdade: ponto fixo RMS %.3f graus, double RMS %.3f graus\n",
+                   sqrt(sq_fix_true / (2 * counted)), sqrt(sq_ref_true / (2 * counted)));
+        }
+    }
+
+    // Custo por atualização
+    volatile int32_t sink = 0;
+    uint64_t t0 = now_ns();
+    for (uint32_t it = 0; it < iterations; it++) {
+        orientation_init(&o, &config);
+        for (size_t i = 1; i < n; i++)
+            orientation_update(&o, s[i].accel, s[i].gyro, (uint32_t)(s[i].t_us - s[i - 1].t_us));
+        sink += o.pitch;
+    }
+    double fix_ns = (double)(now_ns() - t0) / ((double)iterations * (n - 1));
+
+    t0 = now_ns();
+    for (uint32_t it = 0; it < iterations; it++) {
+        memset(&ref, 0, sizeof(ref));
+        for (size_t i = 1; i < n; i++)
+            ref_update(&ref, s[i].accel, s[i].gyro, (uint32_t)(s[i].t_us - s[i - 1].t_us));
+        sink += (int32_t)ref.pitch;
+    }
+    double ref_ns = (double)(now_ns() - t0) / ((double)iterations * (n - 1));
+
+    printf("atualizacao: ponto fixo %.1f ns, double %.1f ns (host)\n", fix_ns, ref_ns);
+
+    free(s);
+
+    bool ok = atan_err <= ATAN2_ERRO_MAX_GRAUS && counted > 0 && max_fix_ref <= FILTRO_ERRO_MAX_GRAUS;
+    printf("%s\n", ok ? "OK" : "FALHA");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+// Verificação do PID (lib/pid) no host.
+//
+// Com a configuração do main (pulso do servo em us a partir da parada,
+// erro em centésimos de grau) e um Ki diferente de zero, confere:
+//   - saturação: erro grande dá exatamente out_max / out_min;
+//   - anti-windup: depois de muito tempo saturado, o integral fica dentro
+//     da faixa de saída e a saída deixa a saturação logo que o erro troca
+//     de sinal;
+//   - zona morta: erro dentro dela não mexe na saída nem no integral;
+//   - derivativo sobre a medida: um degrau no setpoint não dá chute.
+//
+// Uso: pid_check (código de saída 1 se alguma verificação falhar)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pid.h"
+
+// Mesmos limites e zona morta do main.cpp, período de 250 Hz
+#define PERIODO_US 4000
+#define OUT_MIN (500 - 1500)
+#define OUT_MAX (2500 - 1500)
+#define ZONA_MORTA 500                  // 5 graus em centésimos
+
+// Passos até sair da saturação depois da troca de sinal do erro
+#define SAIDA_SATURACAO_MAX 5
+
+static int falhas = 0;
+
+static void confere(int ok, const char *o_que) {
+    printf("%-60s %s\n", o_que, ok ? "ok" : "FALHA");
+    if (!ok) {
+        falhas++;
+    }
+}
+
+static void inicia(pid_controller_t *pid, int32_t kp, int32_t ki, int32_t kd) {
+    pid_config_t cfg = {
+        .kp = kp,
+        .ki = ki,
+        .kd = kd,
+        .period_us = PERIODO_US,
+        .out_min = OUT_MIN,
+        .out_max = OUT_MAX,
+        .deadband = ZONA_MORTA,
+    };
+    pid_init(pid, &cfg);
+}
+
+static int integral_na_faixa(const pid_controller_t *pid) {
+    return pid->integ >= (int64_t)OUT_MIN * PID_Q16_ONE && pid->integ <= (int64_t)OUT_MAX * PID_Q16_ONE;
+}
+
+static void saturacao(void) {
+    pid_controller_t pid;
+
+    inicia(&pid, PID_GAIN(0.111), 0, 0);
+    confere(pid_update(&pid, 0, -90000) == OUT_MAX, "saturacao: erro +900 graus da out_max");
+    confere(pid.saturated, "saturacao: sinalizada");
+    confere(pid_update(&pid, 0, 90000) == OUT_MIN, "saturacao: erro -900 graus da out_min");
+
+    // Kp * 10 graus = 111 us, dentro da faixa
+    int32_t out = pid_update(&pid, 0, -1000);
+    confere(out == 111 && !pid.saturated, "saturacao: erro de 10 graus da 111 us, sem saturar");
+}
+
+static void anti_windup(void) {
+    pid_controller_t pid;
+    int ok_faixa = 1;
+
+    // Ki alto: o integral chega ao limite em ~30 passos (24 us por passo)
+    inicia(&pid, PID_GAIN(0.111), PID_GAIN(2.0), 0);
+    int32_t out = 0;
+    for (int i = 0; i < 5000; i++) {
+        out = pid_update(&pid, 0, -3000);
+        if (!integral_na_faixa(&pid)) {
+            ok_faixa = 0;
+        }
+    }
+    confere(ok_faixa && out == OUT_MAX, "anti-windup: 20 s saturado, integral sempre na faixa");
+
+    // Integração condicional: o integral para ao saturar, em out_max - P
+    // (333 us) mais no máximo um passo, e não no limite da faixa
+    int64_t passo = (int64_t)pid.ki_dt * 3000;
+    confere(pid.integ <= (int64_t)(OUT_MAX - 333) * PID_Q16_ONE + passo,
+            "anti-windup: integral parado em out_max - P");
+
+    // Erro pequeno no outro sentido: a saída deixa a saturação já
+    int passos = 0;
+    while (passos < 1000 && pid_update(&pid, 0, 600) >= OUT_MAX) {
+        passos++;
+    }
+    printf("anti-windup: %d passos para sair da saturacao\n", passos);
+    confere(passos <= SAIDA_SATURACAO_MAX, "anti-windup: sai da saturacao logo apos a troca de sinal");
+
+    // Saturado embaixo, o integral não cresce no sentido da saturação
+    inicia(&pid, PID_GAIN(0.111), PID_GAIN(2.0), 0);
+    for (int i = 0; i < 5000; i++) {
+        pid_update(&pid, 0, 30000);
+    }
+    int64_t integ = pid.integ;
+    pid_update(&pid, 0, 30000);
+    confere(pid.integ == integ && integral_na_faixa(&pid), "anti-windup: integral parado com a saida em out_min");
+}
+
+static void zona_morta(void) {
+    pid_controller_t pid;
+
+    inicia(&pid, PID_GAIN(0.111), 0, 0);
+    confere(pid_update(&pid, 0, ZONA_MORTA - 1) == 0, "zona morta: erro logo abaixo dela da zero");
+    confere(pid_update(&pid, 0, -(ZONA_MORTA - 1)) == 0, "zona morta: idem com o erro negativo");
+    confere(pid_update(&pid, 0, -ZONA_MORTA) != 0, "zona morta: erro no limite ja conta");
+
+    // Com integral acumulado, a zona morta o mantém (saída constante)
+    inicia(&pid, PID_GAIN(0.111), PID_GAIN(0.5), 0);
+    for (int i = 0; i < 100; i++) {
+        pid_update(&pid, 0, -1000);
+    }
+    int64_t integ = pid.integ;
+    int32_t out = pid_update(&pid, 0, -100);
+    int ok = pid.integ == integ;
+    for (int i = 0; i < 100; i++) {
+        ok = ok && pid_update(&pid, 0, 100) == out && pid.integ == integ;
+    }
+    confere(ok && out != 0, "zona morta: integral mantido e saida constante");
+}
+
+static void derivativo(void) {
+    pid_controller_t pid;
+
+    // Kd sozinho: degrau no setpoint não muda a saída; degrau na medida sim
+    inicia(&pid, 0, 0, PID_GAIN(0.002));
+    pid_update(&pid, 0, 0);
+    confere(pid_update(&pid, 3000, 0) == 0, "derivativo: sem chute no degrau do setpoint");
+    int32_t out = pid_update(&pid, 3000, 100);
+    // -Kd * d(medida)/dt = -0,002 * 100 / 4 ms = -50 us
+    confere(out == -50, "derivativo: -Kd * d(medida)/dt no degrau da medida");
+}
+
+int main(void) {
+    saturacao();
+    anti_windup();
+    zona_morta();
+    derivativo();
+
+    printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+    return falhas == 0 ? 0 : 1;
+}
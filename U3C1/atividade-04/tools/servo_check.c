@@ -0,0 +1,209 @@
+// Verificação dos perfis de movimento do servo (lib/servo) no host.
+//
+// Roda o gerenciador quadro a quadro (servo_manager_step, como na
+// interrupção de wrap do PWM) com os limites do main e confere, na posição
+// enviada ao servo (out_q8, 1/256 us), nos dois perfis:
+//   - velocidade, aceleração e (na curva S) jerk dentro dos limites;
+//   - sem ultrapassar o alvo;
+//   - chegada exata: posição igual ao alvo, pulso do PWM igual ao alvo em
+//     us e servo_manager_is_moving falso, dentro do tempo esperado.
+// Movimentos: longo (atinge a velocidade máxima), curto (sem patamar) e um
+// alvo invertido no meio do movimento.
+//
+// Uso: servo_check [-v] (código de saída 1 se alguma verificação falhar)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "servo.h"
+#include "hardware/pwm.h"
+
+// Mesmos limites do main.cpp (e do main.c da atividade 01)
+#define SERVO_PIN 2
+#define SERVO_MIN_PULSE_US 500
+#define SERVO_MAX_PULSE_US 2500
+#define SERVO_VEL_MAX_US_S 4000
+#define SERVO_ACEL_MAX_US_S2 20000
+#define SERVO_JERK_MAX_US_S3 200000
+
+// Folga nas comparações, em 1/256 us por quadro^n: o arredondamento da
+// média móvel da curva S erra a posição em até 1 LSB
+#define FOLGA_Q8 4
+
+// Quadros a mais que o tempo mínimo do movimento até a chegada
+#define CHEGADA_FOLGA_QUADROS 4
+
+#define QUADROS_MAX 2000
+
+typedef struct {
+    const char *nome;
+    uint16_t inicio_us;
+    uint16_t alvo_us;
+    int inverte_no_quadro;      // 0: sem inversão
+    uint16_t alvo_invertido_us;
+} movimento_t;
+
+static const movimento_t movimentos[] = {
+    { "longo", 1000, 2400, 0, 0 },
+    { "curto", 1500, 1560, 0, 0 },
+    { "longo descendo", 2400, 600, 0, 0 },
+    { "invertido no meio", 1000, 2400, 12, 700 },
+    { "invertido na aceleracao", 1500, 2500, 3, 1400 },
+};
+
+static bool verboso = false;
+static int falhas = 0;
+
+static int32_t abs32(int32_t x) {
+    return x < 0 ? -x : x;
+}
+
+// Limite por segundo em 1/256 us por quadro^n, como em servo_manager_set_limits
+static int32_t por_quadro_q8(uint32_t por_s, uint32_t quadros_n) {
+    return (int32_t)(((uint64_t)por_s << 8) / quadros_n);
+}
+
+// Quadros do trapézio para percorrer d (q8) partindo e chegando parado
+static int quadros_minimos(int32_t d, int32_t v, int32_t a) {
+    int32_t d_acel = (int32_t)((int64_t)v * v / a);     // acelera e freia até v
+    if (d <= d_acel) {
+        int q = 0;
+        while ((int64_t)a * q * q < d) q++;             // triângulo: 2 * sqrt(d / a)
+        return 2 * q;
+    }
+    return 2 * (v + a - 1) / a + (d - d_acel + v - 1) / v;
+}
+
+static void confere(bool ok, const char *perfil, const char *mov, const char *o_que) {
+    if (!ok || verboso) {
+        printf("%-8s %-24s %-44s %s\n", perfil, mov, o_que, ok ? "ok" : "FALHA");
+    }
+    if (!ok) {
+        falhas++;
+    }
+}
+
+static void roda(servo_profile_t perfil, const movimento_t *mv) {
+    const char *nome_perfil = perfil == SERVO_PROFILE_S_CURVE ? "curva S" : "trapezio";
+    const servo_limits_t limites = {
+        perfil, SERVO_VEL_MAX_US_S, SERVO_ACEL_MAX_US_S2, SERVO_JERK_MAX_US_S3
+    };
+    int32_t v_lim = por_quadro_q8(SERVO_VEL_MAX_US_S, SERVO_FRAME_HZ);
+    int32_t a_lim = por_quadro_q8(SERVO_ACEL_MAX_US_S2, SERVO_FRAME_HZ * SERVO_FRAME_HZ);
+    int32_t j_lim = por_quadro_q8(SERVO_JERK_MAX_US_S3, SERVO_FRAME_HZ * SERVO_FRAME_HZ * SERVO_FRAME_HZ);
+
+    static servo_manager_t m;
+    servo_manager_init(&m);
+    int idx = servo_manager_add(&m, SERVO_PIN, SERVO_MIN_PULSE_US, SERVO_MAX_PULSE_US);
+    servo_manager_start(&m);
+    servo_manager_set_pulse(&m, (uint)idx, mv->inicio_us);
+    servo_manager_apply(&m);
+    servo_manager_set_limits(&m, (uint)idx, &limites);
+    servo_manager_move_to(&m, (uint)idx, mv->alvo_us);
+
+    const servo_motion_t *mo = &m.motion[idx];
+    uint slice = pwm_gpio_to_slice_num(SERVO_PIN);
+    uint canal = pwm_gpio_to_channel(SERVO_PIN);
+
+    int32_t alvo = (int32_t)mv->alvo_us << 8;
+    int32_t x_ant = (int32_t)mv->inicio_us << 8;
+    int32_t v_ant = 0, a_ant = 0;
+    int32_t v_max = 0, a_max = 0, j_max = 0;
+    int32_t alem = 0;           // maior ultrapassagem do alvo final, q8
+    int quadro = 0;
+    int inicio_final = 0;       // quadro em que o alvo final foi dado
+    int32_t partida = x_ant;    // de onde o movimento até o alvo final sai parado
+    int32_t sentido = mv->alvo_us > mv->inicio_us ? 1 : -1;
+
+    // Depois da chegada, mais alguns quadros para pegar um desvio tardio
+    int parado = 0;
+    while (quadro < QUADROS_MAX && parado < 20) {
+        if (mv->inverte_no_quadro != 0 && quadro == mv->inverte_no_quadro) {
+            alvo = (int32_t)mv->alvo_invertido_us << 8;
+            servo_manager_move_to(&m, (uint)idx, mv->alvo_invertido_us);
+            inicio_final = quadro;
+            sentido = -sentido;
+        }
+
+        servo_manager_step(&m);
+        quadro++;
+
+        int32_t x = mo->out_q8;
+        int32_t v = x - x_ant;
+        int32_t a = v - v_ant;
+        int32_t j = a - a_ant;
+        if (abs32(v) > v_max) v_max = abs32(v);
+        if (abs32(a) > a_max) a_max = abs32(a);
+        if (abs32(j) > j_max) j_max = abs32(j);
+
+        // Ultrapassagem do alvo atual; depois de uma inversão, o ponto mais
+        // longe no sentido antigo é a partida do movimento até o novo alvo
+        int32_t passou = (x - alvo) * sentido;
+        if (passou > alem) alem = passou;
+        if (inicio_final != 0 && (x - partida) * sentido < 0) {
+            partida = x;
+        }
+
+        if (verboso) {
+            printf("  %3d x %9.3f v %8.1f a %9.1f j %10.1f\n", quadro, x / 256.0,
+                   v * (double)SERVO_FRAME_HZ / 256.0,
+                   a * (double)(SERVO_FRAME_HZ * SERVO_FRAME_HZ) / 256.0,
+                   j * (double)(SERVO_FRAME_HZ * SERVO_FRAME_HZ * SERVO_FRAME_HZ) / 256.0);
+        }
+
+        x_ant = x;
+        v_ant = v;
+        a_ant = a;
+        if (!servo_manager_is_moving(&m, (uint)idx)) {
+            parado++;
+        } else {
+            parado = 0;
+        }
+    }
+    int chegada = quadro - parado;
+
+    // Tempo esperado a partir do último alvo: parada (na inversão), trapézio
+    // desde a partida e a janela da curva S
+    int esperado = inicio_final + quadros_minimos(abs32(alvo - partida), v_lim, a_lim) + mo->hist_len;
+    if (inicio_final != 0) {
+        esperado += (v_lim + a_lim - 1) / a_lim;
+    }
+
+    char texto[64];
+    printf("%-8s %-24s v %6.0f us/s  a %7.0f us/s2  j %8.0f us/s3  alem %.3f us  chegada %d quadros\n",
+           nome_perfil, mv->nome, v_max * (double)SERVO_FRAME_HZ / 256.0,
+           a_max * (double)(SERVO_FRAME_HZ * SERVO_FRAME_HZ) / 256.0,
+           j_max * (double)(SERVO_FRAME_HZ * SERVO_FRAME_HZ * SERVO_FRAME_HZ) / 256.0, alem / 256.0, chegada);
+
+    confere(v_max <= v_lim + FOLGA_Q8, nome_perfil, mv->nome, "velocidade <= vel_max");
+    confere(a_max <= a_lim + FOLGA_Q8, nome_perfil, mv->nome, "aceleracao <= acc_max");
+    if (perfil == SERVO_PROFILE_S_CURVE) {
+        confere(j_max <= j_lim + FOLGA_Q8, nome_perfil, mv->nome, "jerk <= jerk_max");
+    }
+    confere(alem <= 0, nome_perfil, mv->nome, "sem ultrapassar o alvo");
+    confere(mo->out_q8 == alvo && mo->pos_q8 == alvo && mo->vel_q8 == 0, nome_perfil, mv->nome,
+            "chegada exata no alvo");
+    confere(pwm_host_level[slice][canal] == (alvo >> 8), nome_perfil, mv->nome, "pulso do PWM igual ao alvo");
+    snprintf(texto, sizeof(texto), "chegada em ate %d quadros", esperado + CHEGADA_FOLGA_QUADROS);
+    confere(chegada <= esperado + CHEGADA_FOLGA_QUADROS, nome_perfil, mv->nome, texto);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verboso = true;
+        } else {
+            fprintf(stderr, "uso: %s [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(movimentos) / sizeof(movimentos[0]); i++) {
+        roda(SERVO_PROFILE_TRAPEZOID, &movimentos[i]);
+        roda(SERVO_PROFILE_S_CURVE, &movimentos[i]);
+    }
+
+    printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+    return falhas == 0 ? 0 : 1;
+}
@@ -76,11 +76,17 @@
 
 /* Hook function related definitions. */
 #define configCHECK_FOR_STACK_OVERFLOW 0
+/* Stack end in the TCB: allocated size for lib/stack_profile */
+#define configRECORD_STACK_HIGH_ADDRESS 1
 #define configUSE_MALLOC_FAILED_HOOK 0
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS 0
+/* Run time stats on the 1 MHz hardware timer: 32 bits, wraps every ~71 min,
+so deltas over shorter windows (lib/diag) stay exact */
+#define configGENERATE_RUN_TIME_STATS 1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE() time_us_32()
 #define configUSE_TRACE_FACILITY 1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
 
@@ -92,7 +98,7 @@
 #define configUSE_TIMERS 1
 #define configTIMER_TASK_PRIORITY (configMAX_PRIORITIES - 1)
 #define configTIMER_QUEUE_LENGTH 10
-#define configTIMER_TASK_STACK_DEPTH 1024
+#define configTIMER_TASK_STACK_DEPTH PILHA_TMR_SVC
 
 /* Interrupt nesting behaviour configuration. */
 /*
@@ -101,11 +107,27 @@
 #define configMAX_API_CALL_INTERRUPT_PRIORITY   [dependent on processor and application]
 */
 
-/* SMP port only */
-#define configNUM_CORES 2
+/* Core-affinity profile (lib/affinity): set CORE_AFFINITY to 1 to pin the
+network tasks to core 0 and the sensing tasks to core 1; see
+lib/affinity/task_affinity.h. */
+#ifndef CORE_AFFINITY
+#define CORE_AFFINITY 0
+#endif
+#define configUSE_CORE_AFFINITY CORE_AFFINITY
+
+/* SMP port only. The kernel reads configNUMBER_OF_CORES (the older
+configNUM_CORES name was ignored). The default build keeps the scheduler
+on one core, as it always ran; both cores are used only together with
+the affinity profile, which keeps the network tasks on core 0 with the
+CYW43/lwIP interrupt. */
+#if CORE_AFFINITY
+#define configNUMBER_OF_CORES 2
+#else
+#define configNUMBER_OF_CORES 1
+#endif
 #define configTICK_CORE 0
 #define configRUN_MULTIPLE_PRIORITIES 1
-#define configUSE_CORE_AFFINITY 0
+#define configUSE_PASSIVE_IDLE_HOOK 0
 
 /* RP2040 specific */
 #define configSUPPORT_PICO_SYNC_INTEROP 1
@@ -134,6 +156,35 @@ to exclude the API function. */
 #define INCLUDE_xTaskResumeFromISR 1
 #define INCLUDE_xQueueGetMutexHolder 1
 
-/* A header file that defines trace macro can be included here. */
+/* Kernel event recorder (lib/trace): set TRACE_RECORDER to 1 to hook the
+trace macros; see lib/trace/trace.h. */
+#ifndef TRACE_RECORDER
+#define TRACE_RECORDER 0
+#endif
+
+#if !defined(__ASSEMBLER__)
+#include "hardware/timer.h"
+
+/* Task stack sizes (lib/stack_profile) */
+#include "task_stacks.h"
+
+/* Per-core idle time for lib/diag */
+#include "diag_hooks.h"
+
+/* Tick timestamps for the lib/periodic jitter measurement */
+#include "periodic_hooks.h"
+
+#if TRACE_RECORDER
+#include "trace_hooks.h"
+#endif
+
+#ifndef traceTASK_SWITCHED_IN
+#define traceTASK_SWITCHED_IN() DIAG_TASK_SWITCHED_IN()
+#endif
+
+#ifndef traceTASK_INCREMENT_TICK
+#define traceTASK_INCREMENT_TICK(xTickCount) PERIODIC_TASK_INCREMENT_TICK(xTickCount)
+#endif
+#endif /* __ASSEMBLER__ */
 
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
@@ -1,24 +1,69 @@
 #include "MPU6050.h"
 
+// Com MPU6050_I2C_BUS=1 (definido pelo CMake do projeto final) as transações
+// passam pela camada com prazo, repetição e recuperação do barramento
+// (lib/i2c_bus); sem ela, chamadas diretas ao SDK. A escolha é explícita
+// para um include path faltando não virar, em silêncio, I2C sem timeout.
+#ifndef MPU6050_I2C_BUS
+#define MPU6050_I2C_BUS 0
+#endif
+#if MPU6050_I2C_BUS
+#include "i2c_bus.h"
+#endif
+
 // Construtor
 MPU6050::MPU6050 (i2c_inst_t *i2c, uint8_t addr) {
 
   this->i2c = i2c;
   this->addr = addr;
+  this->id = 0;
+  this->accelScale = config.accelScale();
+  this->gyroScale = config.gyroScale();
+  this->timestamp = 0;
+  for (int i = 0; i < 7; i++) {
+    raw[i] = 0;
+  }
+}
+
+// Configura o sensor com a configuração padrão
+bool MPU6050::begin() {
+  return begin(Config());
 }
 
 // Configura o sensor
-void MPU6050::begin() {
+bool MPU6050::begin(const Config &config) {
   reset();
   this->id = read8(WHO_AM_I);
-  write8(CONFIG, 0x00);
-  sleep_ms(100);
-  write8(ACCEL_CONFIG, 0x00);
-  write8(GYRO_CONFIG, 0x08);
-  write8(SMPLRT_DIV, 0x00);
-  write8(PWR_MGMT_1, 0x01);
-  write8(PWR_MGMT_2, 0x00);
+  if (!configure(config)) {
+    return false;
+  }
+
+  // Acorda com o PLL do giroscópio X como relógio, todos os eixos ligados
+  uint8_t pwr[3] = { PWR_MGMT_1, 0x01, 0x00 };
+  if (!writeRegs(pwr, sizeof(pwr))) {
+    return false;
+  }
   sleep_ms(20);
+  return true;
+}
+
+// Aplica a configuração em uma única escrita em rajada
+bool MPU6050::configure(const Config &config) {
+  const ConfigImage img = encode(config);
+
+  if (!writeRegs(img.bytes, sizeof(img.bytes))) {
+    return false;
+  }
+
+  this->config = config;
+  this->accelScale = config.accelScale();
+  this->gyroScale = config.gyroScale();
+  return true;
+}
+
+// Configuração aplicada
+const MPU6050::Config &MPU6050::getConfig(void) const {
+  return config;
 }
 
 // Retorna o ID do sensor
@@ -42,17 +87,57 @@ void MPU6050::reset(void) {
   }
 }
 
+// Lê (e limpa, com a interrupção travada) o registrador INT_STATUS
+int MPU6050::readIntStatus(void) {
+  uint8_t val;
+
+  if (!readRegs(INT_STATUS, &val, 1)) {
+    return -1;
+  }
+  return val;
+}
+
+// Lê acelerômetro, temperatura e giroscópio em uma única rajada
+bool MPU6050::read(Sample &sample) {
+  return read(sample, accelScale, gyroScale);
+}
+
+// Idem, com escalas explícitas
+bool MPU6050::read(Sample &sample, float accelScale, float gyroScale) {
+  if (!readRaw()) {
+    return false;
+  }
+
+  sample.timestamp_us = timestamp;
+  for (int i = 0; i < 3; i++) {
+    sample.accel_raw[i] = raw[i];
+    sample.gyro_raw[i] = raw[4 + i];
+  }
+  sample.temp_raw = raw[3];
+
+  getAccel(&sample.accel, accelScale);
+  getGyro(&sample.gyro, gyroScale);
+  sample.temp = getTemp();
+  return true;
+}
+
 // Fornece aceleração em g
+void MPU6050::getAccel(VECT_3D *vect) {
+  getAccel(vect, accelScale);
+}
+
 void MPU6050::getAccel(VECT_3D *vect, float scale) {
-  readRaw();
   vect->x = (float) raw[0] / scale;
   vect->y = (float) raw[1] / scale;
   vect->z = (float) raw[2] / scale;
 }
 
 // Lê giroscópio em graus por segundo
+void MPU6050::getGyro(VECT_3D *vect) {
+  getGyro(vect, gyroScale);
+}
+
 void MPU6050::getGyro(VECT_3D *vect, float scale) {
-  readRaw();
   vect->x = (float) raw[4] / scale;
   vect->y = (float) raw[5] / scale;
   vect->z = (float) raw[6] / scale;
@@ -60,36 +145,39 @@ void MPU6050::getGyro(VECT_3D *vect, float scale) {
 
 // Lê temperatura em C
 float MPU6050::getTemp() {
-  readRaw();
-  return (float) raw[3]/340.0 + 36.53;
+  return (float) raw[3] / 340.0f + 36.53f;
+}
+
+// Instante da última leitura em microssegundos
+uint64_t MPU6050::getTimestamp() {
+  return timestamp;
 }
 
 // Lê os dados brutos
-void MPU6050::readRaw() {
+bool MPU6050::readRaw() {
   uint8_t data[14];
 
-  // Seleciona o primeiro registrador
-  uint8_t reg = ACCEL_OUT;
-  i2c_write_blocking (i2c, addr, &reg, 1, true);
-
-  // Lê os valores
-  i2c_read_blocking (i2c, addr, data, 14, false);
+  // Seleciona o primeiro registrador e lê os valores
+  if (!readRegs(ACCEL_OUT, data, sizeof(data))) {
+    return false;
+  }
+  timestamp = time_us_64();
 
   // Converte para int16
   for (int i = 0; i < 7; i++) {
     raw[i] = (data[2*i] << 8) | data[2*i+1];
   }
+  return true;
 }
 
 // Lê um valor de 8 bits de um registrador
 uint8_t MPU6050::read8 (uint8_t reg)  {  
-  uint8_t val[1];  
+  uint8_t val[1] = { 0 };
     
-  // Seleciona o registrador
-  i2c_write_blocking (i2c, addr, &reg, 1, true);
-
-  // Lê o valor
-  i2c_read_blocking (i2c, addr, val, 1, false);
+  // Sem resposta devolve 0 (os laços do reset terminam)
+  if (!readRegs(reg, val, 1)) {
+    return 0;
+  }
   return val[0];
 } 
 
@@ -99,5 +187,26 @@ void MPU6050::write8 (uint8_t reg, uint8_t val)  {
 
   aux[0] = reg;
   aux[1] = val;
-  i2c_write_blocking (i2c, addr, aux, 2, false);
+  writeRegs(aux, 2);
 } 
+
+// Lê len bytes a partir de um registrador (escrita do endereço + leitura)
+bool MPU6050::readRegs (uint8_t reg, uint8_t *dst, size_t len)  {
+#if MPU6050_I2C_BUS
+  return i2c_bus_write_read (i2c, addr, &reg, 1, dst, len) == (int) len;
+#else
+  if (i2c_write_blocking (i2c, addr, &reg, 1, true) != 1) {
+    return false;
+  }
+  return i2c_read_blocking (i2c, addr, dst, len, false) == (int) len;
+#endif
+}
+
+// Escreve endereço do registrador + valores em uma transação
+bool MPU6050::writeRegs (const uint8_t *src, size_t len)  {
+#if MPU6050_I2C_BUS
+  return i2c_bus_write (i2c, addr, src, len, false) == (int) len;
+#else
+  return i2c_write_blocking (i2c, addr, src, len, false) == (int) len;
+#endif
+}
@@ -0,0 +1,48 @@
+#include "task_affinity.h"
+
+#define AFINIDADE_ATIVA (configUSE_CORE_AFFINITY && configNUMBER_OF_CORES > 1)
+
+#if AFINIDADE_ATIVA
+static struct {
+    TaskHandle_t handle;
+    UBaseType_t afinidade;
+} tasks[TASK_AFFINITY_MAX];
+static size_t n_tasks;
+#endif
+
+BaseType_t task_affinity_create(TaskFunction_t tarefa, const char *nome, configSTACK_DEPTH_TYPE pilha,
+                                void *pv, UBaseType_t prioridade, UBaseType_t afinidade, TaskHandle_t *handle)
+{
+#if AFINIDADE_ATIVA
+    TaskHandle_t criada = NULL;
+    BaseType_t ok = xTaskCreateAffinitySet(tarefa, nome, pilha, pv, prioridade, afinidade, &criada);
+
+    if (ok == pdPASS && afinidade != AFINIDADE_LIVRE) {
+        taskENTER_CRITICAL();
+        if (n_tasks < TASK_AFFINITY_MAX) {
+            tasks[n_tasks].handle = criada;
+            tasks[n_tasks].afinidade = afinidade;
+            n_tasks++;
+        }
+        taskEXIT_CRITICAL();
+    }
+    if (handle != NULL) {
+        *handle = criada;
+    }
+    return ok;
+#else
+    (void)afinidade;
+    return xTaskCreate(tarefa, nome, pilha, pv, prioridade, handle);
+#endif
+}
+
+void task_affinity_apply(bool fixar)
+{
+#if AFINIDADE_ATIVA
+    for (size_t i = 0; i < n_tasks; i++) {
+        vTaskCoreAffinitySet(tasks[i].handle, fixar ? tasks[i].afinidade : AFINIDADE_LIVRE);
+    }
+#else
+    (void)fixar;
+#endif
+}
@@ -0,0 +1,96 @@
+#ifndef TASK_AFFINITY_H
+#define TASK_AFFINITY_H
+
+#include <stdbool.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Núcleo de cada task no perfil de afinidade (CORE_AFFINITY=ON).
+//
+// A rede fica no núcleo 0: o cyw43_arch_init roda no main, antes do
+// escalonador, e a interrupção do CYW43 (e com ela o lwIP, no modo
+// threadsafe_background) fica nesse núcleo. O sensoriamento vai para o
+// núcleo 1, longe das rajadas da rede; a interrupção do pino INT do MPU6050
+// acompanha, porque é ligada no init do sensor, já na task do executor.
+// As demais tasks ficam livres.
+//
+// Sem o perfil (ou com um só núcleo) task_affinity_create é um xTaskCreate.
+//
+// O nome da constante segue task_stacks.h: AFINIDADE_ + nome da task.
+
+#ifndef CORE_AFFINITY
+#define CORE_AFFINITY 0
+#endif
+
+// Modo de comparação (AFFINITY_COMPARE): alterna entre o perfil e tasks
+// livres para medir o jitter dos dois (task_affinity_apply)
+#ifndef AFFINITY_COMPARE
+#define AFFINITY_COMPARE 0
+#endif
+
+#define NUCLEO_REDE 0
+#define NUCLEO_SENSORES 1
+
+#define AFINIDADE_LIVRE ((UBaseType_t)tskNO_AFFINITY)
+#define AFINIDADE_NUCLEO_REDE ((UBaseType_t)(1u << NUCLEO_REDE))
+#define AFINIDADE_NUCLEO_SENSORES ((UBaseType_t)(1u << NUCLEO_SENSORES))
+
+// Rede
+#ifndef AFINIDADE_WIFIMANAGER
+#define AFINIDADE_WIFIMANAGER AFINIDADE_NUCLEO_REDE
+#endif
+
+#ifndef AFINIDADE_MQTT_TASK
+#define AFINIDADE_MQTT_TASK AFINIDADE_NUCLEO_REDE
+#endif
+
+#ifndef AFINIDADE_MQTT
+#define AFINIDADE_MQTT AFINIDADE_NUCLEO_REDE
+#endif
+
+// Sensoriamento e display (amostragem a 100 ms)
+#ifndef AFINIDADE_SENSORES
+#define AFINIDADE_SENSORES AFINIDADE_NUCLEO_SENSORES
+#endif
+
+#ifndef AFINIDADE_DISPLAY
+#define AFINIDADE_DISPLAY AFINIDADE_NUCLEO_SENSORES
+#endif
+
+#ifndef AFINIDADE_DISPLAY_I2C
+#define AFINIDADE_DISPLAY_I2C AFINIDADE_NUCLEO_SENSORES
+#endif
+
+// Tasks de fundo
+#ifndef AFINIDADE_DLOG
+#define AFINIDADE_DLOG AFINIDADE_LIVRE
+#endif
+
+#ifndef AFINIDADE_DIAG
+#define AFINIDADE_DIAG AFINIDADE_LIVRE
+#endif
+
+#ifndef AFINIDADE_TRACE
+#define AFINIDADE_TRACE AFINIDADE_LIVRE
+#endif
+
+#ifndef AFINIDADE_PILHAS
+#define AFINIDADE_PILHAS AFINIDADE_LIVRE
+#endif
+
+#ifndef AFINIDADE_COMPARACAO
+#define AFINIDADE_COMPARACAO AFINIDADE_LIVRE
+#endif
+
+// Tasks registradas para o modo de comparação
+#define TASK_AFFINITY_MAX 16
+
+// xTaskCreate com a afinidade do perfil
+BaseType_t task_affinity_create(TaskFunction_t tarefa, const char *nome, configSTACK_DEPTH_TYPE pilha,
+                                void *pv, UBaseType_t prioridade, UBaseType_t afinidade, TaskHandle_t *handle);
+
+// Aplica o perfil (fixar) ou libera todas as tasks criadas acima
+void task_affinity_apply(bool fixar);
+
+#endif
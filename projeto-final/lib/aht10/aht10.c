@@ -7,6 +7,9 @@ static bool aht10_write_command(AHT10_Handle *dev, uint8_t cmd, uint8_t arg1, ui
 
 bool AHT10_Init(AHT10_Handle *dev) {
     if (!dev) return false;
+    dev->typical_ms_x16 = AHT10_TYPICAL_MS << 4;
+    dev->count = 0;
+    if (dev->oversampling == 0) dev->oversampling = 1;
     if (!AHT10_SoftReset(dev)) return false;
     dev->iface.delay_ms(20);
     dev->initialized = aht10_write_command(dev, AHT10_CMD_INITIALIZE, 0x08, 0x00);
@@ -28,22 +31,114 @@ bool AHT10_IsBusy(AHT10_Handle *dev) {
     return (status & 0x80) != 0;
 }
 
-bool AHT10_ReadTemperatureHumidity(AHT10_Handle *dev, float *temperature, float *humidity) {
+void AHT10_SetOversampling(AHT10_Handle *dev, uint8_t samples) {
+    if (samples < 1) samples = 1;
+    if (samples > AHT10_MAX_OVERSAMPLING) samples = AHT10_MAX_OVERSAMPLING;
+    dev->oversampling = samples;
+    dev->count = 0;
+}
+
+bool AHT10_StartMeasurement(AHT10_Handle *dev) {
     if (!dev || !dev->initialized) return false;
+    return aht10_write_command(dev, AHT10_CMD_MEASURE, 0x33, 0x00);
+}
+
+// Espera inicial um pouco abaixo do típico: em geral basta uma consulta
+uint32_t AHT10_ConversionWaitMs(const AHT10_Handle *dev) {
+    return ((uint32_t)dev->typical_ms_x16 * 7u) >> 7;
+}
+
+// Conversão para centésimos com inteiros (valores brutos de 20 bits):
+// UR = raw * 10000 / 2^20 e T = raw * 20000 / 2^20 - 5000
+static void aht10_convert(const uint8_t *raw, AHT10_Reading *r) {
+    uint32_t raw_hum = ((uint32_t)(raw[1]) << 12) | ((uint32_t)(raw[2]) << 4) | (raw[3] >> 4);
+    uint32_t raw_temp = (((uint32_t)(raw[3] & 0x0F)) << 16) | ((uint32_t)(raw[4]) << 8) | raw[5];
 
-    if (!aht10_write_command(dev, AHT10_CMD_MEASURE, 0x33, 0x00)) return false;
-    dev->iface.delay_ms(80);
+    r->humidity_c100 = (int32_t)((raw_hum * 625u + (1u << 15)) >> 16);
+    r->temperature_c100 = (int32_t)((raw_temp * 625u + (1u << 14)) >> 15) - 5000;
+}
 
+// Mediana por inserção (poucas amostras)
+static int32_t aht10_median(int32_t *v, uint8_t n) {
+    for (uint8_t i = 1; i < n; i++) {
+        int32_t x = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+    return v[n / 2];
+}
+
+AHT10_Status AHT10_Poll(AHT10_Handle *dev, AHT10_Reading *reading, uint32_t elapsed_ms) {
     uint8_t raw[6];
-    if (dev->iface.i2c_read(AHT10_I2C_ADDRESS, raw, 6) != 0) return false;
 
-    if ((raw[0] & 0x80) != 0) return false; // ainda ocupado
+    if (dev->iface.i2c_read(AHT10_I2C_ADDRESS, raw, 6) != 0) {
+        AHT10_Abort(dev);
+        return AHT10_ERROR;
+    }
+    if ((raw[0] & 0x80) != 0) return AHT10_BUSY;
 
-    uint32_t raw_hum = ((uint32_t)(raw[1]) << 12) | ((uint32_t)(raw[2]) << 4) | (raw[3] >> 4);
-    uint32_t raw_temp = (((uint32_t)(raw[3] & 0x0F)) << 16) | ((uint32_t)(raw[4]) << 8) | raw[5];
+    // Média móvel (1/4) do tempo até o fim da conversão
+    int32_t erro = (int32_t)(elapsed_ms << 4) - (int32_t)dev->typical_ms_x16;
+    dev->typical_ms_x16 = (uint16_t)((int32_t)dev->typical_ms_x16 + erro / 4);
 
-    *humidity = (raw_hum * 100.0f) / 1048576.0f;
-    *temperature = ((raw_temp * 200.0f) / 1048576.0f) - 50.0f;
+    if (dev->oversampling <= 1) {
+        aht10_convert(raw, reading);
+        return AHT10_READY;
+    }
 
+    aht10_convert(raw, &dev->samples[dev->count++]);
+    if (dev->count < dev->oversampling) return AHT10_SAMPLE;
+
+    int32_t temp[AHT10_MAX_OVERSAMPLING];
+    int32_t hum[AHT10_MAX_OVERSAMPLING];
+    for (uint8_t i = 0; i < dev->count; i++) {
+        temp[i] = dev->samples[i].temperature_c100;
+        hum[i] = dev->samples[i].humidity_c100;
+    }
+    reading->temperature_c100 = aht10_median(temp, dev->count);
+    reading->humidity_c100 = aht10_median(hum, dev->count);
+    dev->count = 0;
+    return AHT10_READY;
+}
+
+void AHT10_Abort(AHT10_Handle *dev) {
+    dev->count = 0;
+}
+
+bool AHT10_Read(AHT10_Handle *dev, AHT10_Reading *reading) {
+    AHT10_Status status = AHT10_SAMPLE;
+
+    while (status == AHT10_SAMPLE) {
+        if (!AHT10_StartMeasurement(dev)) {
+            AHT10_Abort(dev);
+            return false;
+        }
+
+        uint32_t elapsed = AHT10_ConversionWaitMs(dev);
+        dev->iface.delay_ms(elapsed);
+
+        while ((status = AHT10_Poll(dev, reading, elapsed)) == AHT10_BUSY) {
+            if (elapsed >= AHT10_TIMEOUT_MS) {
+                AHT10_Abort(dev);
+                return false;
+            }
+            dev->iface.delay_ms(AHT10_POLL_MS);
+            elapsed += AHT10_POLL_MS;
+        }
+    }
+    return status == AHT10_READY;
+}
+
+bool AHT10_ReadTemperatureHumidity(AHT10_Handle *dev, float *temperature, float *humidity) {
+    AHT10_Reading r;
+
+    if (!AHT10_Read(dev, &r)) return false;
+
+    *humidity = r.humidity_c100 / 100.0f;
+    *temperature = r.temperature_c100 / 100.0f;
     return true;
-}
\ No newline at end of file
+}
@@ -19,9 +19,39 @@ typedef struct {
     void (*delay_ms)(uint32_t ms);
 } AHT10_Interface;
 
+// Espera pelo fim da conversão: consulta ao bit busy a cada AHT10_POLL_MS,
+// desistindo após AHT10_TIMEOUT_MS
+#define AHT10_POLL_MS 2
+#define AHT10_TIMEOUT_MS 150
+#define AHT10_TYPICAL_MS 80
+
+// Máximo de amostras por leitura na sobreamostragem (mediana)
+#define AHT10_MAX_OVERSAMPLING 7
+
+// Medição em inteiros: centésimos de °C e de %UR
+typedef struct {
+    int32_t temperature_c100;
+    int32_t humidity_c100;
+} AHT10_Reading;
+
+typedef enum {
+    AHT10_ERROR,
+    AHT10_BUSY,       // conversão em andamento, consultar de novo
+    AHT10_SAMPLE,     // amostra guardada; falta iniciar a próxima da mediana
+    AHT10_READY,      // leitura completa em *reading
+} AHT10_Status;
+
 typedef struct {
     AHT10_Interface iface;
     bool initialized;
+
+    // Tempo típico de conversão aprendido, em 1/16 ms
+    uint16_t typical_ms_x16;
+
+    // Sobreamostragem: mediana de oversampling amostras (1 = desligada)
+    uint8_t oversampling;
+    uint8_t count;
+    AHT10_Reading samples[AHT10_MAX_OVERSAMPLING];
 } AHT10_Handle;
 
 // Inicializa o sensor
@@ -36,4 +66,22 @@ bool AHT10_SoftReset(AHT10_Handle *dev);
 // Verifica se o sensor está ocupado (status busy)
 bool AHT10_IsBusy(AHT10_Handle *dev);
 
+// Número de amostras combinadas pela mediana em cada leitura (1 a AHT10_MAX_OVERSAMPLING)
+void AHT10_SetOversampling(AHT10_Handle *dev, uint8_t samples);
+
+// Leitura em etapas, para liberar o barramento durante a conversão:
+// inicia a medição, espera AHT10_ConversionWaitMs e chama AHT10_Poll a cada
+// AHT10_POLL_MS enquanto retornar AHT10_BUSY. elapsed_ms é o tempo desde o
+// início da medição (usado para aprender o tempo típico de conversão).
+bool AHT10_StartMeasurement(AHT10_Handle *dev);
+uint32_t AHT10_ConversionWaitMs(const AHT10_Handle *dev);
+AHT10_Status AHT10_Poll(AHT10_Handle *dev, AHT10_Reading *reading, uint32_t elapsed_ms);
+
+// Descarta as amostras parciais da mediana; chamar sempre que uma leitura
+// em etapas for abandonada, para a próxima não misturar conversões antigas
+void AHT10_Abort(AHT10_Handle *dev);
+
+// As mesmas etapas em uma chamada, esperando com iface.delay_ms
+bool AHT10_Read(AHT10_Handle *dev, AHT10_Reading *reading);
+
 #endif // AHT10_H
\ No newline at end of file
@@ -1,18 +1,187 @@
 #include "bh1750.h"
 #include "pico/stdlib.h"
+#include "i2c_bus.h"
+
+#define BH1750_POWER_ON 0x01
+#define BH1750_MTREG_ALTO 0x40    // bits 7..5 do MTreg
+#define BH1750_MTREG_BAIXO 0x60   // bits 4..0 do MTreg
+
+// Tempo máximo de conversão com o MTreg padrão (datasheet)
+#define BH1750_TEMPO_L_MS 24
+#define BH1750_TEMPO_H_MS 180
+
+// Faixas do ajuste automático em lux, com 25 % de histerese entre elas
+#define BH1750_LUX_ESCURO 10.0f
+#define BH1750_LUX_CLARO 1000.0f
+#define BH1750_HISTERESE 1.25f
+
+// Contagem alvo no escuro (margem de 4x antes de saturar) e contagem a
+// partir da qual a leitura é tratada como saturada
+#define BH1750_RAW_ALVO 16384
+#define BH1750_RAW_SATURADO 65000
 
 void bh1750_init(i2c_inst_t *i2c) {
     uint8_t cmd = 0x10;  // Modo Continuo de Alta Resolução
-    i2c_write_blocking(i2c, BH1750_ADDR, &cmd, 1, false);
+    i2c_bus_write(i2c, BH1750_ADDR, &cmd, 1, false);
     sleep_ms(180);  // Tempo de conversão típico
 }
 
 float bh1750_read_lux(i2c_inst_t *i2c) {
     uint8_t data[2];
-    if (i2c_read_blocking(i2c, BH1750_ADDR, data, 2, false) != 2) {
+    if (i2c_bus_read(i2c, BH1750_ADDR, data, 2, false) != 2) {
         return -1.0f;
     }
 
     uint16_t raw = (data[0] << 8) | data[1];
     return raw / 1.2f;  // Conversão para lux
-}
\ No newline at end of file
+}
+
+static bool bh1750_cmd(i2c_inst_t *i2c, uint8_t cmd) {
+    return i2c_bus_write(i2c, BH1750_ADDR, &cmd, 1, false) == 1;
+}
+
+bool bh1750_begin(bh1750_t *dev, i2c_inst_t *i2c, bh1750_modo_t modo, uint8_t mtreg) {
+    dev->i2c = i2c;
+    dev->automatico = false;
+    dev->tempo_max_ms = 0;
+    dev->raw = 0;
+
+    // Força o envio do MTreg e do modo
+    dev->modo = modo;
+    dev->mtreg = 0;
+
+    if (!bh1750_cmd(i2c, BH1750_POWER_ON)) {
+        return false;
+    }
+    return bh1750_configure(dev, modo, mtreg);
+}
+
+bool bh1750_configure(bh1750_t *dev, bh1750_modo_t modo, uint8_t mtreg) {
+    if (mtreg < BH1750_MTREG_MIN) mtreg = BH1750_MTREG_MIN;
+    if (mtreg > BH1750_MTREG_MAX) mtreg = BH1750_MTREG_MAX;
+
+    if (modo == dev->modo && mtreg == dev->mtreg) {
+        return true;
+    }
+
+    if (mtreg != dev->mtreg) {
+        if (!bh1750_cmd(dev->i2c, BH1750_MTREG_ALTO | (mtreg >> 5)) ||
+            !bh1750_cmd(dev->i2c, BH1750_MTREG_BAIXO | (mtreg & 0x1F))) {
+            return false;
+        }
+        dev->mtreg = mtreg;
+    }
+
+    // O comando de modo reinicia a conversão com o novo MTreg
+    if (!bh1750_cmd(dev->i2c, (uint8_t)modo)) {
+        return false;
+    }
+    dev->modo = modo;
+    return true;
+}
+
+void bh1750_set_auto(bh1750_t *dev, bool automatico, uint16_t tempo_max_ms) {
+    dev->automatico = automatico;
+    dev->tempo_max_ms = tempo_max_ms;
+}
+
+uint16_t bh1750_tempo_modo_ms(bh1750_modo_t modo, uint8_t mtreg) {
+    uint32_t base = (modo == BH1750_MODO_L) ? BH1750_TEMPO_L_MS : BH1750_TEMPO_H_MS;
+
+    // O tempo de integração é proporcional ao MTreg
+    return (uint16_t)((base * mtreg + BH1750_MTREG_PADRAO - 1) / BH1750_MTREG_PADRAO);
+}
+
+uint16_t bh1750_tempo_ms(const bh1750_t *dev) {
+    return bh1750_tempo_modo_ms(dev->modo, dev->mtreg);
+}
+
+float bh1750_raw_to_lux(uint16_t raw, bh1750_modo_t modo, uint8_t mtreg) {
+    uint32_t div = (uint32_t)mtreg * (modo == BH1750_MODO_H2 ? 2u : 1u);
+
+    // lux = raw / 1,2 com o MTreg padrão, inversamente proporcional ao MTreg
+    return (float)raw * (BH1750_MTREG_PADRAO / 1.2f) / (float)div;
+}
+
+// Próximo ajuste a partir da última leitura
+static void bh1750_auto_next(const bh1750_t *dev, float lux, bh1750_modo_t *modo, uint8_t *mtreg) {
+    bh1750_modo_t alvo;
+    uint32_t mt;
+
+    if (dev->raw >= BH1750_RAW_SATURADO) {
+        // Saturado: volta ao ajuste de maior alcance
+        alvo = BH1750_MODO_L;
+        mt = BH1750_MTREG_MIN;
+    } else {
+        float escuro = (dev->modo == BH1750_MODO_H2) ? BH1750_LUX_ESCURO * BH1750_HISTERESE
+                                                     : BH1750_LUX_ESCURO / BH1750_HISTERESE;
+        float claro = (dev->modo == BH1750_MODO_L) ? BH1750_LUX_CLARO / BH1750_HISTERESE
+                                                   : BH1750_LUX_CLARO * BH1750_HISTERESE;
+
+        alvo = (lux < escuro) ? BH1750_MODO_H2 : (lux > claro) ? BH1750_MODO_L : BH1750_MODO_H;
+
+        // Fator de escala que leva a contagem ao alvo (raw = lux * mt * div / 57,5)
+        uint32_t div = (alvo == BH1750_MODO_H2) ? 2u : 1u;
+        float k = (float)BH1750_RAW_ALVO * (BH1750_MTREG_PADRAO / 1.2f) / (lux > 0.1f ? lux : 0.1f);
+        mt = (k / div > BH1750_MTREG_MAX) ? BH1750_MTREG_MAX : (uint32_t)(k / div);
+
+        // Só o H2 sobe o MTreg (sensibilidade); L e H apenas o reduzem para
+        // não saturar, mantendo a conversão curta
+        if (alvo != BH1750_MODO_H2 && mt > BH1750_MTREG_PADRAO) {
+            mt = BH1750_MTREG_PADRAO;
+        }
+        if (mt < BH1750_MTREG_MIN) {
+            mt = BH1750_MTREG_MIN;
+        }
+    }
+
+    // Respeita o tempo máximo: primeiro reduz o MTreg, depois troca para um
+    // modo mais rápido
+    while (dev->tempo_max_ms != 0 && bh1750_tempo_modo_ms(alvo, (uint8_t)mt) > dev->tempo_max_ms) {
+        uint32_t base = (alvo == BH1750_MODO_L) ? BH1750_TEMPO_L_MS : BH1750_TEMPO_H_MS;
+        uint32_t mt_max = (uint32_t)dev->tempo_max_ms * BH1750_MTREG_PADRAO / base;
+
+        if (mt_max >= BH1750_MTREG_MIN) {
+            mt = mt_max;
+            break;
+        }
+        if (alvo == BH1750_MODO_L) {
+            mt = BH1750_MTREG_MIN;
+            break;
+        }
+        alvo = (alvo == BH1750_MODO_H2) ? BH1750_MODO_H : BH1750_MODO_L;
+    }
+
+    *modo = alvo;
+    *mtreg = (uint8_t)mt;
+}
+
+bool bh1750_read(bh1750_t *dev, float *lux, bool *reajustado) {
+    uint8_t data[2];
+
+    if (reajustado) {
+        *reajustado = false;
+    }
+    if (i2c_bus_read(dev->i2c, BH1750_ADDR, data, 2, false) != 2) {
+        return false;
+    }
+
+    dev->raw = (uint16_t)((data[0] << 8) | data[1]);
+    *lux = bh1750_raw_to_lux(dev->raw, dev->modo, dev->mtreg);
+
+    if (dev->automatico) {
+        bh1750_modo_t modo;
+        uint8_t mtreg;
+
+        bh1750_auto_next(dev, *lux, &modo, &mtreg);
+        if (modo != dev->modo || mtreg != dev->mtreg) {
+            if (!bh1750_configure(dev, modo, mtreg)) {
+                return false;
+            }
+            if (reajustado) {
+                *reajustado = true;
+            }
+        }
+    }
+    return true;
+}
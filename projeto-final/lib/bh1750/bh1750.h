@@ -5,7 +5,53 @@
 
 #define BH1750_ADDR 0x23
 
+// Faixa do registrador de tempo de medição (MTreg); 69 é o padrão
+#define BH1750_MTREG_MIN 31
+#define BH1750_MTREG_PADRAO 69
+#define BH1750_MTREG_MAX 254
+
+// Modos de medição contínua (o valor é o comando)
+typedef enum {
+    BH1750_MODO_L = 0x13,     // 4 lx, 16 ms típico (24 ms máx.) com MTreg 69
+    BH1750_MODO_H = 0x10,     // 1 lx, 120 ms típico (180 ms máx.)
+    BH1750_MODO_H2 = 0x11,    // 0,5 lx, 120 ms típico (180 ms máx.)
+} bh1750_modo_t;
+
+// Sensor com modo e MTreg ajustáveis. No modo automático cada leitura
+// escolhe o próximo ajuste: modo L (rápido) com muita luz, H na faixa
+// intermediária e H2 com MTreg alto no escuro, limitado por tempo_max_ms.
+typedef struct {
+    i2c_inst_t *i2c;
+    bh1750_modo_t modo;
+    uint8_t mtreg;
+    bool automatico;
+    uint16_t tempo_max_ms;    // maior conversão aceita no automático (0: sem limite)
+    uint16_t raw;             // última contagem lida
+} bh1750_t;
+
+// Interface original: modo H contínuo, MTreg padrão
 void bh1750_init(i2c_inst_t *i2c);
 float bh1750_read_lux(i2c_inst_t *i2c);
 
-#endif
\ No newline at end of file
+// Liga o sensor e inicia a medição contínua no modo e MTreg dados
+bool bh1750_begin(bh1750_t *dev, i2c_inst_t *i2c, bh1750_modo_t modo, uint8_t mtreg);
+
+// Troca modo/MTreg (só envia o que mudou) e reinicia a medição
+bool bh1750_configure(bh1750_t *dev, bh1750_modo_t modo, uint8_t mtreg);
+
+// Liga ou desliga o ajuste automático
+void bh1750_set_auto(bh1750_t *dev, bool automatico, uint16_t tempo_max_ms);
+
+// Tempo máximo de uma conversão no ajuste atual; é o intervalo mínimo
+// entre leituras para que cada uma traga um valor novo
+uint16_t bh1750_tempo_ms(const bh1750_t *dev);
+uint16_t bh1750_tempo_modo_ms(bh1750_modo_t modo, uint8_t mtreg);
+
+// Lê a última conversão em lux. No automático, já reprograma o sensor para
+// a próxima; nesse caso retorna true em *reajustado.
+bool bh1750_read(bh1750_t *dev, float *lux, bool *reajustado);
+
+// Conversão da contagem para lux em um ajuste
+float bh1750_raw_to_lux(uint16_t raw, bh1750_modo_t modo, uint8_t mtreg);
+
+#endif
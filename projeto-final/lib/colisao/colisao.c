@@ -0,0 +1,83 @@
+#include "colisao.h"
+#include "motion_irq.h"
+
+bool colisao_init(void *ctx)
+{
+    colisao_ctx_t *c = (colisao_ctx_t *)ctx;
+
+    // Limiar comparado com |a|^2 em LSB^2, sem float nem raiz por amostra
+    impact_init(&c->detector, LIMIAR_COLISAO, MPU_LSB_POR_G);
+    c->magnitude = 1.0f;
+
+    bool ok = mpu6050_enable_motion(c->dev, MOVIMENTO_LIMIAR_MG, MOVIMENTO_DURACAO_MS);
+    motion_irq_init(c->pino_int);
+    return ok;
+}
+
+bool colisao_evento(void *ctx)
+{
+    colisao_ctx_t *c = (colisao_ctx_t *)ctx;
+
+    c->movimento = motion_irq_pending();
+    return c->movimento;
+}
+
+sensor_passo_t colisao_start(void *ctx, uint32_t *espera_ms)
+{
+    colisao_ctx_t *c = (colisao_ctx_t *)ctx;
+    (void)espera_ms;
+
+    // Sem interrupção (liberação pelo período): nada a ler
+    c->n = 0;
+    return c->movimento ? SENSOR_AGUARDA : SENSOR_PRONTO;
+}
+
+sensor_passo_t colisao_fetch(void *ctx, uint32_t *espera_ms)
+{
+    colisao_ctx_t *c = (colisao_ctx_t *)ctx;
+
+    // Falha no meio da janela: processa o que já foi lido
+    if (!motion_irq_read(c->dev, c->janela, c->n)) {
+        return SENSOR_PRONTO;
+    }
+    if (++c->n < IMPACTO_JANELA_AMOSTRAS) {
+        *espera_ms = IMPACTO_PERIODO_MS;
+        return SENSOR_AGUARDA;
+    }
+    return SENSOR_PRONTO;
+}
+
+void colisao_decode(void *ctx)
+{
+    colisao_ctx_t *c = (colisao_ctx_t *)ctx;
+
+    // Sem movimento: caixa parada, só a gravidade
+    c->magnitude = 1.0f;
+    c->impacto = false;
+
+    if (c->movimento) {
+        motion_irq_capture_end(c->n);
+        c->movimento = false;
+    }
+
+    if (c->n > 0) {
+        impact_features_t caracteristicas;
+
+        impact_process(&c->detector, c->janela, c->n, &caracteristicas);
+        c->magnitude = impact_mag2_to_mg(&c->detector, caracteristicas.pico_mag2) / 1000.0f;
+
+        if (caracteristicas.primeiro_acima >= 0) {
+            c->impacto = true;
+            c->colisao = true;
+            c->fim_colisao = xTaskGetTickCount() + pdMS_TO_TICKS(COLISAO_RETENCAO_MS);
+        }
+    }
+
+    if (c->colisao && (int32_t)(xTaskGetTickCount() - c->fim_colisao) >= 0) {
+        c->colisao = false;
+    }
+
+    if (c->resultado != NULL) {
+        c->resultado(c);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef COLISAO_H
+#define COLISAO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpu_wrapper.h"
+#include "impact.h"
+#include "i2c_bus.h"
+#include "sensor_sched.h"
+
+// Detecção de colisão com o MPU6050 como sensor de lib/sensor_sched.
+//
+// A detecção de movimento fica no próprio sensor: o pino INT acorda o
+// executor (lib/motion_irq), que só então lê uma janela de amostras, uma a
+// cada IMPACTO_PERIODO_MS, entre as leituras dos outros sensores. A janela
+// vai para lib/impact. Sem movimento, a cada MPU_ESPERA_MS a aceleração
+// volta a 1 g e a retenção da colisão é conferida.
+//
+// Os passos são os mesmos no firmware (main.c) e na simulação no port
+// Posix (tools/freertos_posix/motion_sim); cada um publica o resultado no
+// callback do contexto.
+
+#define LIMIAR_COLISAO 2.5f
+
+// LSB por g do MPU6050 na configuração padrão (+/- 2 g)
+#define MPU_LSB_POR_G 16384
+
+#define MOVIMENTO_LIMIAR_MG 300
+#define MOVIMENTO_DURACAO_MS 1
+#define IMPACTO_JANELA_AMOSTRAS 16
+#define IMPACTO_PERIODO_MS 2
+#define MPU_ESPERA_MS 1000
+#define COLISAO_RETENCAO_MS 10000
+
+// Velocidade do barramento do MPU6050, usada no prazo
+#ifndef COLISAO_I2C_BAUDRATE
+#define COLISAO_I2C_BAUDRATE 100000
+#endif
+
+// Prazo da captura a partir da interrupção: um período de amostragem por
+// amostra mais um tick (leitura e arredondamento da espera) e o pior caso
+// da leitura do INT_STATUS e de uma amostra (a que falha encerra a janela)
+#define MPU_PRAZO_MS \
+    (IMPACTO_JANELA_AMOSTRAS * (IMPACTO_PERIODO_MS + 1) + \
+     (I2C_BUS_WORST_CASE_US(1 + 1, COLISAO_I2C_BAUDRATE) + \
+      I2C_BUS_WORST_CASE_US(1 + 14, COLISAO_I2C_BAUDRATE)) / 1000 + 1)
+
+typedef struct colisao_ctx colisao_ctx_t;
+
+struct colisao_ctx {
+    mpu6050_dev_t *dev;
+    uint pino_int;
+    // Chamado no fim de cada leitura, na task do executor e sem o mutex
+    // do barramento
+    void (*resultado)(const colisao_ctx_t *c);
+
+    impact_detector_t detector;
+    int16_t janela[3 * IMPACTO_JANELA_AMOSTRAS];
+    size_t n;
+    bool movimento;
+
+    // Última leitura
+    float magnitude;        // pico da janela em g (1 g sem movimento)
+    bool impacto;           // a janela passou do limiar
+    bool colisao;           // retida por COLISAO_RETENCAO_MS após o impacto
+    TickType_t fim_colisao;
+};
+
+// Passos do sensor (ctx: colisao_ctx_t). O init roda na task do executor,
+// que é a acordada pelo pino INT.
+bool colisao_init(void *ctx);
+bool colisao_evento(void *ctx);
+sensor_passo_t colisao_start(void *ctx, uint32_t *espera_ms);
+sensor_passo_t colisao_fetch(void *ctx, uint32_t *espera_ms);
+void colisao_decode(void *ctx);
+
+#endif
@@ -0,0 +1,172 @@
+#include "diag.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+
+// Tempo ocioso por núcleo: a task IDLE que entra abre um trecho ocioso e a
+// próxima troca no mesmo núcleo o fecha. Cada núcleo só escreve o seu.
+static volatile uint32_t ocioso_us[configNUMBER_OF_CORES];
+static volatile uint32_t desde_us[configNUMBER_OF_CORES];
+static volatile bool em_ocio[configNUMBER_OF_CORES];
+
+void diag_core_switched_in(bool ociosa) {
+    uint core = get_core_num();
+    uint32_t agora = time_us_32();
+
+    if (core >= configNUMBER_OF_CORES) {
+        return;
+    }
+    if (em_ocio[core]) {
+        ocioso_us[core] += agora - desde_us[core];
+    }
+    desde_us[core] = agora;
+    em_ocio[core] = ociosa;
+}
+
+uint32_t diag_core_idle_us(unsigned core) {
+    if (core >= configNUMBER_OF_CORES) {
+        return 0;
+    }
+
+    // Leitura de outro núcleo pode pegar a troca no meio: o erro é de um
+    // trecho, corrigido na janela seguinte
+    uint32_t total = ocioso_us[core];
+    if (em_ocio[core]) {
+        total += time_us_32() - desde_us[core];
+    }
+    return total;
+}
+
+void diag_init(diag_t *d) {
+    memset(d, 0, sizeof(*d));
+    diag_update(d);
+}
+
+static uint16_t permil(uint32_t parte, uint32_t total) {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t p = (uint64_t)parte * 1000u / total;
+    return (uint16_t)(p > 1000u ? 1000u : p);
+}
+
+bool diag_update(diag_t *d) {
+    configRUN_TIME_COUNTER_TYPE total;
+    UBaseType_t n = uxTaskGetSystemState(d->status, DIAG_MAX_TASKS, &total);
+
+    if (n == 0) {
+        return false;
+    }
+
+    // Contadores da janela anterior, para casar pelo número da task
+    struct {
+        UBaseType_t numero;
+        configRUN_TIME_COUNTER_TYPE tempo;
+    } ant[DIAG_MAX_TASKS];
+    uint8_t n_ant = d->n_tasks;
+    for (uint8_t i = 0; i < n_ant; i++) {
+        ant[i].numero = d->tasks[i].numero;
+        ant[i].tempo = d->tasks[i].tempo;
+    }
+
+    d->janela_us = (uint32_t)(total - d->total_ant);
+    d->total_ant = total;
+    d->t_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t *st = &d->status[i];
+        diag_task_t *t = &d->tasks[i];
+        configRUN_TIME_COUNTER_TYPE inicio = 0;
+
+        // Task nova na janela: conta desde a criação
+        for (uint8_t k = 0; k < n_ant; k++) {
+            if (ant[k].numero == st->xTaskNumber) {
+                inicio = ant[k].tempo;
+                break;
+            }
+        }
+
+        snprintf(t->nome, sizeof(t->nome), "%s", st->pcTaskName);
+        t->numero = st->xTaskNumber;
+        t->prioridade = (uint8_t)st->uxCurrentPriority;
+        t->ociosa = false;
+        for (BaseType_t c = 0; c < configNUMBER_OF_CORES; c++) {
+            if (st->xHandle == xTaskGetIdleTaskHandleForCore(c)) {
+                t->ociosa = true;
+            }
+        }
+        t->pilha_livre = (uint32_t)st->usStackHighWaterMark * sizeof(StackType_t);
+        t->cpu_permil = permil((uint32_t)(st->ulRunTimeCounter - inicio), d->janela_us);
+        t->tempo = st->ulRunTimeCounter;
+    }
+    d->n_tasks = (uint8_t)n;
+
+    for (unsigned c = 0; c < configNUMBER_OF_CORES; c++) {
+        uint32_t ocioso = diag_core_idle_us(c);
+        d->carga_permil[c] = (uint16_t)(1000u - permil(ocioso - d->ocioso_ant[c], d->janela_us));
+        d->ocioso_ant[c] = ocioso;
+    }
+
+#if DIAG_HEAP
+    d->heap_livre = (uint32_t)xPortGetFreeHeapSize();
+    d->heap_minimo = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+#endif
+    return true;
+}
+
+size_t diag_format_json(const diag_t *d, char *buf, size_t len) {
+    // Reserva para fechar o JSON com o contador de omitidas
+    const size_t reserva = sizeof("],\"omit\":99}");
+    size_t n = 0;
+    unsigned omitidas = 0;
+    int w;
+
+    if (len <= reserva) {
+        return 0;
+    }
+
+    w = snprintf(buf, len, "{\"t\":%lu,\"cpu\":[", (unsigned long)d->t_ms);
+    n = (size_t)w;
+    for (unsigned c = 0; c < configNUMBER_OF_CORES && n < len; c++) {
+        w = snprintf(buf + n, len - n, "%s%u", c ? "," : "", (unsigned)d->carga_permil[c]);
+        n += (size_t)w;
+    }
+    if (n < len) {
+        w = snprintf(buf + n, len - n, "],\"heap\":[%lu,%lu],\"tasks\":[",
+                     (unsigned long)d->heap_livre, (unsigned long)d->heap_minimo);
+        n += (size_t)w;
+    }
+    if (n + reserva >= len) {
+        buf[0] = '\0';
+        return 0;
+    }
+
+    bool primeira = true;
+    for (uint8_t i = 0; i < d->n_tasks; i++) {
+        const diag_task_t *t = &d->tasks[i];
+        char item[48];
+
+        if (t->ociosa) {
+            continue;
+        }
+        w = snprintf(item, sizeof(item), "%s[\"%s\",%u,%lu]", primeira ? "" : ",", t->nome,
+                     (unsigned)t->cpu_permil, (unsigned long)t->pilha_livre);
+        if (n + (size_t)w + reserva >= len) {
+            omitidas++;
+            continue;
+        }
+        memcpy(buf + n, item, (size_t)w);
+        n += (size_t)w;
+        primeira = false;
+    }
+
+    if (omitidas) {
+        w = snprintf(buf + n, len - n, "],\"omit\":%u}", omitidas);
+    } else {
+        w = snprintf(buf + n, len - n, "]}");
+    }
+    return n + (size_t)w;
+}
@@ -0,0 +1,70 @@
+#ifndef DIAG_H
+#define DIAG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Diagnóstico de execução a partir das run-time stats do FreeRTOS
+// (configGENERATE_RUN_TIME_STATS, contador de 1 MHz).
+//
+// Cada diag_update fecha uma janela: uso de CPU de cada task e carga de
+// cada núcleo desde a chamada anterior, mais a menor folga de pilha já
+// vista em cada task e o heap livre. diag_format_json gera a mensagem
+// compacta publicada no MQTT.
+
+#define DIAG_MAX_TASKS 16
+
+// Sem heap_4/heap_5 (ex.: heap_3 no host) não há contagem do heap
+#ifndef DIAG_HEAP
+#define DIAG_HEAP 1
+#endif
+
+typedef struct {
+    char nome[configMAX_TASK_NAME_LEN];
+    UBaseType_t numero;             // TaskStatus_t.xTaskNumber
+    uint16_t cpu_permil;            // da janela, em milésimos de um núcleo
+    uint8_t prioridade;
+    bool ociosa;                    // task IDLE do kernel
+    uint32_t pilha_livre;           // high-water mark, em bytes
+    configRUN_TIME_COUNTER_TYPE tempo;  // contador acumulado (para a próxima janela)
+} diag_task_t;
+
+typedef struct {
+    uint32_t t_ms;
+    uint32_t janela_us;
+    uint16_t carga_permil[configNUMBER_OF_CORES];
+    uint32_t heap_livre;
+    uint32_t heap_minimo;
+    uint8_t n_tasks;
+    diag_task_t tasks[DIAG_MAX_TASKS];
+
+    // Início da janela
+    configRUN_TIME_COUNTER_TYPE total_ant;
+    uint32_t ocioso_ant[configNUMBER_OF_CORES];
+
+    // Área de trabalho do uxTaskGetSystemState
+    TaskStatus_t status[DIAG_MAX_TASKS];
+} diag_t;
+
+// Abre a primeira janela
+void diag_init(diag_t *d);
+
+// Fecha a janela atual e abre a próxima; false (sem atualizar nada) se
+// houver mais tasks que DIAG_MAX_TASKS
+bool diag_update(diag_t *d);
+
+// {"t":ms,"cpu":[núcleos],"heap":[livre,mínimo],"tasks":[[nome,cpu,pilha],...]}
+// sem as tasks IDLE; o que não couber em len é contado em "omit"
+size_t diag_format_json(const diag_t *d, char *buf, size_t len);
+
+// Tempo ocioso acumulado de um núcleo (us, volta a cada ~71 min)
+uint32_t diag_core_idle_us(unsigned core);
+
+// Chamado pelo hook traceTASK_SWITCHED_IN (diag_hooks.h)
+void diag_core_switched_in(bool ociosa);
+
+#endif
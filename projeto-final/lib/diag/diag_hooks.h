@@ -0,0 +1,20 @@
+#ifndef DIAG_HOOKS_H
+#define DIAG_HOOKS_H
+
+// Contagem do tempo ocioso de cada núcleo (lib/diag), feita na troca de
+// contexto. Incluído no fim do FreeRTOSConfig.h; a macro é expandida em
+// tasks.c, onde pxCurrentTCB já é a task que entra.
+
+#include <stdbool.h>
+
+void diag_core_switched_in(bool ociosa);
+
+#if configNUMBER_OF_CORES > 1
+#define DIAG_TASK_OCIOSA() ((pxCurrentTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE) != 0U)
+#else
+#define DIAG_TASK_OCIOSA() (pxCurrentTCB == xIdleTaskHandles[0])
+#endif
+
+#define DIAG_TASK_SWITCHED_IN() diag_core_switched_in(DIAG_TASK_OCIOSA())
+
+#endif
@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "display_manager.h"
+#include "task.h"
+#include "semphr.h"
+#include "task_stacks.h"
+#include "task_affinity.h"
+
+//===============================
+// Estado dos painéis
+//===============================
+typedef struct {
+    ssd1306_t *disp;
+    uint8_t *shadow;        // último quadro submetido (pool do ssd1306)
+    uint8_t bus;
+    volatile bool dirty;
+    display_stats_t stats;
+} display_panel_t;
+
+static display_panel_t panels[DISPLAY_MANAGER_MAX_PANELS];
+static size_t panel_count = 0;
+
+// Protege shadow/dirty; só é mantido durante cópias de memória, nunca durante o I2C
+static SemaphoreHandle_t xPanelMutex = NULL;
+
+// Uma task de envio por barramento, cada uma com seu buffer de transmissão
+static TaskHandle_t bus_task[DISPLAY_MANAGER_BUSES];
+static uint8_t tx_buffer[DISPLAY_MANAGER_BUSES][SSD1306_POOL_BUFSIZE + 1];
+static UBaseType_t task_priority;
+
+static void display_bus_task(void *pv);
+
+_Static_assert(SSD1306_POOL_BUFFERS >= 2 * DISPLAY_MANAGER_MAX_PANELS,
+               "SSD1306_POOL_BUFFERS precisa de dois buffers por painel gerenciado");
+
+
+//=========================================================
+//                   Inicialização
+//=========================================================
+bool display_manager_init(UBaseType_t priority) {
+    if (xPanelMutex == NULL) {
+        xPanelMutex = xSemaphoreCreateMutex();
+    }
+    task_priority = priority;
+    return xPanelMutex != NULL;
+}
+
+int display_manager_add(ssd1306_t *disp) {
+    if (xPanelMutex == NULL || panel_count >= DISPLAY_MANAGER_MAX_PANELS) {
+        return -1;
+    }
+
+    uint8_t bus = (uint8_t)i2c_hw_index(disp->i2c_i);
+    uint8_t *shadow = ssd1306_pool_alloc(disp->bufsize);
+    if (shadow == NULL) {
+        printf("[DISPLAY] ERRO: pool do ssd1306 esgotado!\n");
+        return -1;
+    }
+
+    // Primeira tela neste barramento: cria a task de envio dele
+    if (bus_task[bus] == NULL) {
+        char name[] = "display_i2cX";
+        name[sizeof(name) - 2] = '0' + bus;
+        if (task_affinity_create(display_bus_task, name, PILHA_DISPLAY_I2C, (void *)(uintptr_t)bus, task_priority,
+                                 AFINIDADE_DISPLAY_I2C, &bus_task[bus]) != pdPASS) {
+            ssd1306_pool_free(shadow);
+            return -1;
+        }
+    }
+
+    xSemaphoreTake(xPanelMutex, portMAX_DELAY);
+    int id = (int)panel_count;
+    panels[id] = (display_panel_t){
+        .disp = disp,
+        .shadow = shadow,
+        .bus = bus,
+        .dirty = false,
+    };
+    panel_count++;
+    xSemaphoreGive(xPanelMutex);
+
+    return id;
+}
+
+
+//=========================================================
+//               Submissão de quadros
+//=========================================================
+bool display_manager_submit(int id) {
+    if (id < 0 || (size_t)id >= panel_count) {
+        return false;
+    }
+
+    display_panel_t *panel = &panels[id];
+
+    xSemaphoreTake(xPanelMutex, portMAX_DELAY);
+    if (panel->dirty) {
+        // O quadro anterior ainda não saiu: vale só o mais recente
+        panel->stats.dropped++;
+    }
+    memcpy(panel->shadow, panel->disp->buffer, panel->disp->bufsize);
+    panel->dirty = true;
+    xSemaphoreGive(xPanelMutex);
+
+    xTaskNotifyGive(bus_task[panel->bus]);
+    return true;
+}
+
+bool display_manager_get_stats(int id, display_stats_t *stats) {
+    if (id < 0 || (size_t)id >= panel_count) {
+        return false;
+    }
+
+    xSemaphoreTake(xPanelMutex, portMAX_DELAY);
+    *stats = panels[id].stats;
+    xSemaphoreGive(xPanelMutex);
+    return true;
+}
+
+
+//=========================================================
+//          Task de envio (uma por barramento)
+//=========================================================
+static void display_bus_task(void *pv) {
+    const uint8_t bus = (uint8_t)(uintptr_t)pv;
+    uint8_t *frame = tx_buffer[bus] + 1;
+    size_t next = 0;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Round-robin entre os painéis deste barramento até não sobrar nenhum pendente
+        bool sent;
+        do {
+            sent = false;
+            display_panel_t *panel = NULL;
+
+            // Painéis podem ser registrados a qualquer momento: a busca
+            // (panel_count e dirty) e a cópia são feitas com o mutex
+            xSemaphoreTake(xPanelMutex, portMAX_DELAY);
+            size_t count = panel_count;
+            for (size_t n = 0; n < count; n++) {
+                size_t i = (next + n) % count;
+
+                if (panels[i].bus == bus && panels[i].dirty) {
+                    panel = &panels[i];
+                    next = i + 1;
+                    break;
+                }
+            }
+            if (panel != NULL) {
+                memcpy(frame, panel->shadow, panel->disp->bufsize);
+                panel->dirty = false;
+            }
+            xSemaphoreGive(xPanelMutex);
+
+            if (panel != NULL) {
+                ssd1306_show_frame(panel->disp, frame);
+
+                xSemaphoreTake(xPanelMutex, portMAX_DELAY);
+                panel->stats.flushes++;
+                xSemaphoreGive(xPanelMutex);
+
+                sent = true;
+            }
+        } while (sent);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef DISPLAY_MANAGER_H
+#define DISPLAY_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "ssd1306.h"
+
+// Quantidade máxima de displays gerenciados. Cada painel usa dois buffers
+// do pool do ssd1306 (o do ssd1306_init e a cópia do gerenciador): o alvo
+// que usa o gerenciador define SSD1306_POOL_BUFFERS para todas as fontes.
+#ifndef DISPLAY_MANAGER_MAX_PANELS
+#define DISPLAY_MANAGER_MAX_PANELS 4
+#endif
+
+// Quantidade de barramentos I2C do RP2040
+#define DISPLAY_MANAGER_BUSES 2
+
+typedef struct {
+    uint32_t flushes;   // quadros enviados ao display
+    uint32_t dropped;   // quadros substituídos antes de serem enviados
+} display_stats_t;
+
+// Prepara o gerenciador; as tasks de envio (uma por barramento) usam esta prioridade
+bool display_manager_init(UBaseType_t priority);
+
+// Registra um display já iniciado com ssd1306_init.
+// Reserva um buffer extra do pool do ssd1306. Retorna o id do painel ou -1.
+int display_manager_add(ssd1306_t *disp);
+
+// Agenda o envio do buffer atual do display sem esperar o barramento.
+// O quadro é copiado na hora; o desenho pode continuar logo em seguida.
+bool display_manager_submit(int id);
+
+// Estatísticas de envio do painel
+bool display_manager_get_stats(int id, display_stats_t *stats);
+
+#endif
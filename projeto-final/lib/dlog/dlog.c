@@ -0,0 +1,161 @@
+#include "dlog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+
+_Static_assert((DLOG_RING_SIZE & (DLOG_RING_SIZE - 1)) == 0, "DLOG_RING_SIZE precisa ser potencia de 2");
+
+// Um anel por núcleo: cada núcleo é o único produtor do seu (as tasks e
+// interrupções do mesmo núcleo se serializam com as interrupções
+// desligadas por poucas instruções) e dlog_flush é o único consumidor
+typedef struct {
+    dlog_record_t rec[DLOG_RING_SIZE];
+    volatile uint32_t head;     // escrito só pelo produtor
+    volatile uint32_t tail;     // escrito só pelo consumidor
+    uint32_t gravados;
+    uint32_t descartados;
+    uint16_t seq;
+} dlog_ring_t;
+
+static dlog_ring_t rings[DLOG_CORES];
+static uint32_t formatados;
+
+void dlog_write(const char *fmt, uint8_t nargs, const dlog_arg_t *args) {
+    if (nargs > DLOG_MAX_ARGS) {
+        nargs = DLOG_MAX_ARGS;
+    }
+
+    // O núcleo só é lido com as interrupções desligadas: antes disso a task
+    // pode ser preemptada e migrar, e escreveria no anel do outro núcleo
+    uint32_t irq = save_and_disable_interrupts();
+    uint core = get_core_num();
+    dlog_ring_t *r = &rings[core];
+    uint32_t head = r->head;
+
+    if (head - r->tail >= DLOG_RING_SIZE) {
+        r->descartados++;
+        restore_interrupts(irq);
+        return;
+    }
+
+    dlog_record_t *rec = &r->rec[head & (DLOG_RING_SIZE - 1)];
+    rec->fmt = fmt;
+    rec->timestamp_us = time_us_32();
+    rec->nargs = nargs;
+    rec->core = (uint8_t)core;
+    rec->seq = r->seq++;
+    for (uint8_t i = 0; i < nargs; i++) {
+        rec->args[i] = args[i];
+    }
+
+    // Registro completo antes de publicar o novo head
+    __dmb();
+    r->head = head + 1;
+    r->gravados++;
+    restore_interrupts(irq);
+}
+
+// Formata um registro: percorre fmt e passa cada especificador ao snprintf
+// com o argumento no tipo certo
+static void dlog_format(const dlog_record_t *rec, char *out, size_t len) {
+    const char *p = rec->fmt;
+    size_t n = 0;
+    uint8_t arg = 0;
+
+    while (*p != '\0' && n + 1 < len) {
+        if (*p != '%') {
+            out[n++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[n++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Especificador: flags, largura, precisão e modificador até a conversão
+        char spec[16];
+        size_t s = 0;
+        spec[s++] = *p++;
+        while (*p != '\0' && strchr("-+ #0123456789.lhzjt", *p) != NULL && s < sizeof(spec) - 2) {
+            if (*p != 'l' && *p != 'h' && *p != 'z' && *p != 'j' && *p != 't') {
+                spec[s++] = *p;
+            }
+            p++;
+        }
+        char conv = *p;
+        if (conv == '\0') {
+            break;
+        }
+        p++;
+        spec[s++] = conv;
+        spec[s] = '\0';
+
+        dlog_arg_t v = arg < rec->nargs ? rec->args[arg] : 0;
+        arg++;
+
+        int w;
+        switch (conv) {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            union { uint32_t u; float f; } c = { .u = (uint32_t)v };
+            w = snprintf(out + n, len - n, spec, (double)c.f);
+            break;
+        }
+        case 's':
+            w = snprintf(out + n, len - n, spec, (const char *)v);
+            break;
+        case 'p':
+            w = snprintf(out + n, len - n, spec, (void *)v);
+            break;
+        case 'd': case 'i': case 'c':
+            w = snprintf(out + n, len - n, spec, (int)(int32_t)v);
+            break;
+        default:
+            w = snprintf(out + n, len - n, spec, (unsigned)v);
+            break;
+        }
+        if (w < 0) {
+            break;
+        }
+        n += (size_t)w < len - n ? (size_t)w : len - n - 1;
+    }
+    out[n] = '\0';
+}
+
+size_t dlog_flush(void) {
+    char linha[160];
+    size_t total = 0;
+
+    for (uint core = 0; core < DLOG_CORES; core++) {
+        dlog_ring_t *r = &rings[core];
+
+        while (r->tail != r->head) {
+            __dmb();
+            const dlog_record_t *rec = &r->rec[r->tail & (DLOG_RING_SIZE - 1)];
+            dlog_format(rec, linha, sizeof(linha));
+            printf("[%lu.%06lu c%u] %s", (unsigned long)(rec->timestamp_us / 1000000u),
+                   (unsigned long)(rec->timestamp_us % 1000000u), (unsigned)rec->core, linha);
+
+            // Libera o slot só depois de formatado
+            __dmb();
+            r->tail = r->tail + 1;
+            total++;
+        }
+    }
+    formatados += (uint32_t)total;
+    return total;
+}
+
+void dlog_get_stats(dlog_stats_t *stats) {
+    stats->gravados = 0;
+    stats->descartados = 0;
+    for (uint core = 0; core < DLOG_CORES; core++) {
+        stats->gravados += rings[core].gravados;
+        stats->descartados += rings[core].descartados;
+    }
+    stats->formatados = formatados;
+}
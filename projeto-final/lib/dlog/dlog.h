@@ -0,0 +1,93 @@
+#ifndef DLOG_H
+#define DLOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Log adiado em binário.
+//
+// DLOG(fmt, ...) só grava o ponteiro da string de formato, o instante e os
+// argumentos crus (32 bits cada) no anel do núcleo que chamou; a formatação
+// e o envio pela stdio ficam para dlog_flush, chamado por uma task de baixa
+// prioridade. Custa algumas dezenas de ciclos, sem bloquear na USB.
+//
+// Restrições:
+// - fmt precisa ser uma string constante (o ponteiro é guardado, não o texto);
+// - %s só com strings que continuam válidas até o flush (constantes);
+// - float/double viram float de 32 bits; sem argumentos de 64 bits (%lld),
+//   exceto ponteiros quando compilado para o host;
+// - no máximo DLOG_MAX_ARGS argumentos.
+
+#define DLOG_MAX_ARGS 5
+
+// Registros por núcleo (potência de 2); 32 bytes cada
+#define DLOG_RING_SIZE 64
+
+#define DLOG_CORES 2
+
+// Um registro (32 bytes no RP2040) guarda cada argumento em uma palavra
+typedef uintptr_t dlog_arg_t;
+
+typedef struct {
+    const char *fmt;
+    uint32_t timestamp_us;
+    uint8_t nargs;
+    uint8_t core;
+    uint16_t seq;
+    dlog_arg_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
+typedef struct {
+    uint32_t gravados;
+    uint32_t descartados;   // anel cheio: o registro novo é perdido
+    uint32_t formatados;
+} dlog_stats_t;
+
+void dlog_write(const char *fmt, uint8_t nargs, const dlog_arg_t *args);
+
+// Formata e envia (printf) tudo o que estiver nos anéis; retorna quantos registros
+size_t dlog_flush(void);
+
+void dlog_get_stats(dlog_stats_t *stats);
+
+// Conversão de cada argumento para 32 bits, preservando os bits do float
+static inline dlog_arg_t dlog_arg_float(double v) {
+    union { float f; uint32_t u; } c = { .f = (float)v };
+    return (dlog_arg_t)c.u;
+}
+
+static inline dlog_arg_t dlog_arg_int(uint32_t v) {
+    return (dlog_arg_t)v;
+}
+
+static inline dlog_arg_t dlog_arg_ptr(const void *p) {
+    return (dlog_arg_t)p;
+}
+
+#define DLOG_ARG(x) _Generic((x),                 \
+        float: dlog_arg_float,                    \
+        double: dlog_arg_float,                   \
+        char *: dlog_arg_ptr,                     \
+        const char *: dlog_arg_ptr,               \
+        void *: dlog_arg_ptr,                     \
+        const void *: dlog_arg_ptr,               \
+        default: dlog_arg_int)(x)
+
+#define DLOG_NARGS(...) DLOG_NARGS_(0, ##__VA_ARGS__, 5, 4, 3, 2, 1, 0)
+#define DLOG_NARGS_(z, a, b, c, d, e, n, ...) n
+#define DLOG_CAT(a, b) DLOG_CAT_(a, b)
+#define DLOG_CAT_(a, b) a##b
+
+#define DLOG_0(fmt) dlog_write(fmt, 0, NULL)
+#define DLOG_1(fmt, a) dlog_write(fmt, 1, (const dlog_arg_t[]){ DLOG_ARG(a) })
+#define DLOG_2(fmt, a, b) dlog_write(fmt, 2, (const dlog_arg_t[]){ DLOG_ARG(a), DLOG_ARG(b) })
+#define DLOG_3(fmt, a, b, c) dlog_write(fmt, 3, (const dlog_arg_t[]){ DLOG_ARG(a), DLOG_ARG(b), DLOG_ARG(c) })
+#define DLOG_4(fmt, a, b, c, d) \
+    dlog_write(fmt, 4, (const dlog_arg_t[]){ DLOG_ARG(a), DLOG_ARG(b), DLOG_ARG(c), DLOG_ARG(d) })
+#define DLOG_5(fmt, a, b, c, d, e) \
+    dlog_write(fmt, 5, (const dlog_arg_t[]){ DLOG_ARG(a), DLOG_ARG(b), DLOG_ARG(c), DLOG_ARG(d), DLOG_ARG(e) })
+
+#define DLOG(fmt, ...) DLOG_CAT(DLOG_, DLOG_NARGS(__VA_ARGS__))(fmt, ##__VA_ARGS__)
+
+#endif
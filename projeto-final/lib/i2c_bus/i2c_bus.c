@@ -0,0 +1,237 @@
+#include "i2c_bus.h"
+#include "hardware/gpio.h"
+
+#define I2C_BUS_COUNT 2
+
+typedef struct {
+    bool configurado;
+    uint sda;
+    uint scl;
+    uint baudrate;
+} i2c_bus_t;
+
+typedef struct {
+    i2c_inst_t *i2c;
+    uint8_t addr;
+    i2c_bus_stats_t stats;
+} i2c_bus_device_t;
+
+static i2c_bus_t buses[I2C_BUS_COUNT];
+
+// Os dispositivos são registrados na primeira transação, que acontece na
+// inicialização dos drivers, antes das tasks disputarem o barramento
+static i2c_bus_device_t devices[I2C_BUS_MAX_DEVICES];
+static size_t device_count = 0;
+
+static i2c_bus_t *i2c_bus_get(i2c_inst_t *i2c)
+{
+    return &buses[i2c_hw_index(i2c)];
+}
+
+static i2c_bus_stats_t *i2c_bus_device(i2c_inst_t *i2c, uint8_t addr)
+{
+    for (size_t i = 0; i < device_count; i++) {
+        if (devices[i].i2c == i2c && devices[i].addr == addr) {
+            return &devices[i].stats;
+        }
+    }
+
+    if (device_count >= I2C_BUS_MAX_DEVICES) {
+        return NULL;
+    }
+
+    i2c_bus_device_t *dev = &devices[device_count++];
+    dev->i2c = i2c;
+    dev->addr = addr;
+    return &dev->stats;
+}
+
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate)
+{
+    i2c_bus_t *bus = i2c_bus_get(i2c);
+
+    bus->sda = sda;
+    bus->scl = scl;
+    bus->baudrate = baudrate;
+    bus->configurado = true;
+
+    i2c_init(i2c, baudrate);
+    gpio_set_function(sda, GPIO_FUNC_I2C);
+    gpio_set_function(scl, GPIO_FUNC_I2C);
+    gpio_pull_up(sda);
+    gpio_pull_up(scl);
+}
+
+// Linha em dreno aberto: nível baixo é saída em 0, nível alto é entrada com pull-up
+static inline void i2c_bus_line(uint pin, bool alto)
+{
+    gpio_set_dir(pin, alto ? GPIO_IN : GPIO_OUT);
+}
+
+void i2c_bus_recover(i2c_inst_t *i2c)
+{
+    i2c_bus_t *bus = i2c_bus_get(i2c);
+
+    if (!bus->configurado) {
+        return;
+    }
+
+    // Meio período do clock do barramento
+    uint32_t meio = 500000u / bus->baudrate + 1;
+
+    gpio_set_function(bus->sda, GPIO_FUNC_SIO);
+    gpio_set_function(bus->scl, GPIO_FUNC_SIO);
+    gpio_put(bus->sda, 0);
+    gpio_put(bus->scl, 0);
+    i2c_bus_line(bus->sda, true);
+    i2c_bus_line(bus->scl, true);
+    sleep_us(meio);
+
+    // Pulsos em SCL até o escravo terminar o byte e soltar SDA
+    for (int i = 0; i < I2C_BUS_CLEAR_PULSES && !gpio_get(bus->sda); i++) {
+        i2c_bus_line(bus->scl, false);
+        sleep_us(meio);
+        i2c_bus_line(bus->scl, true);
+        sleep_us(meio);
+    }
+
+    // STOP: SDA sobe com SCL alto
+    i2c_bus_line(bus->sda, false);
+    sleep_us(meio);
+    i2c_bus_line(bus->scl, true);
+    sleep_us(meio);
+    i2c_bus_line(bus->sda, true);
+    sleep_us(meio);
+
+    // Devolve os pinos ao periférico, reiniciado do zero
+    i2c_init(i2c, bus->baudrate);
+    gpio_set_function(bus->sda, GPIO_FUNC_I2C);
+    gpio_set_function(bus->scl, GPIO_FUNC_I2C);
+}
+
+uint32_t i2c_bus_frame_us(uint32_t len, uint baudrate)
+{
+    // Endereço + dados, 9 bits por byte. O produto é feito em 64 bits: com o
+    // size_t de 32 bits do RP2040 ele estoura a partir de 477 bytes.
+    return I2C_BUS_FRAME_US(len, baudrate);
+}
+
+uint32_t i2c_bus_deadline_us(i2c_inst_t *i2c, size_t len)
+{
+    i2c_bus_t *bus = i2c_bus_get(i2c);
+    uint baudrate = bus->configurado ? bus->baudrate : 100000;
+
+    // Margem de 2x para clock stretching
+    return I2C_BUS_DEADLINE_US(len, baudrate);
+}
+
+uint32_t i2c_bus_worst_case_us(i2c_inst_t *i2c, size_t len)
+{
+    i2c_bus_t *bus = i2c_bus_get(i2c);
+    uint baudrate = bus->configurado ? bus->baudrate : 100000;
+
+    // Todas as tentativas estouram o prazo, cada uma seguida de um bus
+    // clear (inclusive a última, para a próxima transação achar o
+    // barramento livre); len + 1 cobre o endereço do repeated start
+    return I2C_BUS_WORST_CASE_US(len, baudrate);
+}
+
+// Uma tentativa: escrita (opcional) seguida de leitura (opcional) com
+// repeated start entre as duas, as duas fases dentro do mesmo prazo.
+// Retorna o resultado da última fase.
+static int i2c_bus_attempt(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t wlen,
+                           uint8_t *dst, size_t rlen, bool nostop, uint32_t prazo)
+{
+    uint64_t fim = time_us_64() + prazo;
+    int ret = 0;
+
+    if (wlen > 0) {
+        ret = i2c_write_timeout_us(i2c, addr, src, wlen, rlen > 0 || nostop, prazo);
+        if (ret != (int)wlen) {
+            return ret < 0 ? ret : PICO_ERROR_GENERIC;
+        }
+    }
+    if (rlen > 0) {
+        // A leitura fica só com o que sobrou do prazo da tentativa
+        uint64_t agora = time_us_64();
+        if (agora >= fim) {
+            return PICO_ERROR_TIMEOUT;
+        }
+        ret = i2c_read_timeout_us(i2c, addr, dst, rlen, nostop, (uint)(fim - agora));
+        if (ret != (int)rlen) {
+            return ret < 0 ? ret : PICO_ERROR_GENERIC;
+        }
+    }
+    return ret;
+}
+
+static int i2c_bus_transfer(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t wlen,
+                            uint8_t *dst, size_t rlen, bool nostop)
+{
+    i2c_bus_stats_t *st = i2c_bus_device(i2c, addr);
+    // Bytes das duas fases, mais o endereço do repeated start
+    uint32_t prazo = i2c_bus_deadline_us(i2c, wlen + rlen + (wlen > 0 && rlen > 0 ? 1 : 0));
+    uint64_t inicio = time_us_64();
+    int ret = PICO_ERROR_GENERIC;
+
+    for (int tentativa = 0; tentativa <= I2C_BUS_RETRIES; tentativa++) {
+        if (tentativa > 0 && st) {
+            st->retentativas++;
+        }
+
+        ret = i2c_bus_attempt(i2c, addr, src, wlen, dst, rlen, nostop, prazo);
+        if (ret >= 0) {
+            break;
+        }
+
+        if (ret == PICO_ERROR_TIMEOUT) {
+            // Escravo pode ter ficado segurando SDA no meio de um byte
+            if (st) {
+                st->timeouts++;
+                st->recuperacoes++;
+            }
+            i2c_bus_recover(i2c);
+        } else if (st) {
+            st->nacks++;
+        }
+    }
+
+    if (st) {
+        uint32_t latencia = (uint32_t)(time_us_64() - inicio);
+        st->transacoes++;
+        st->latencia_total_us += latencia;
+        if (latencia > st->latencia_max_us) {
+            st->latencia_max_us = latencia;
+        }
+        if (ret < 0) {
+            st->erros++;
+        }
+    }
+    return ret;
+}
+
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return i2c_bus_transfer(i2c, addr, src, len, NULL, 0, nostop);
+}
+
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return i2c_bus_transfer(i2c, addr, NULL, 0, dst, len, nostop);
+}
+
+int i2c_bus_write_read(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t wlen, uint8_t *dst, size_t rlen)
+{
+    return i2c_bus_transfer(i2c, addr, src, wlen, dst, rlen, false);
+}
+
+bool i2c_bus_get_stats(i2c_inst_t *i2c, uint8_t addr, i2c_bus_stats_t *stats)
+{
+    for (size_t i = 0; i < device_count; i++) {
+        if (devices[i].i2c == i2c && devices[i].addr == addr) {
+            *stats = devices[i].stats;
+            return true;
+        }
+    }
+    return false;
+}
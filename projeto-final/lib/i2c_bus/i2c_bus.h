@@ -0,0 +1,94 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Camada de transporte I2C compartilhada pelos drivers.
+//
+// Cada tentativa tem um prazo (proporcional ao tamanho e à velocidade do
+// barramento) que vale para a escrita e a leitura juntas. A transação é
+// repetida até I2C_BUS_RETRIES vezes em caso de erro e, a cada timeout,
+// passa por um bus clear (9 pulsos em SCL + STOP) com o periférico
+// reiniciado. O pior caso de uma transação fica limitado a
+// i2c_bus_worst_case_us. Erros e latência são contados por dispositivo.
+
+#ifndef I2C_BUS_RETRIES
+#define I2C_BUS_RETRIES 2
+#endif
+
+#ifndef I2C_BUS_MAX_DEVICES
+#define I2C_BUS_MAX_DEVICES 8
+#endif
+
+// Prazo mínimo de uma transação (clock stretching, início de conversão etc.)
+#ifndef I2C_BUS_TIMEOUT_MIN_US
+#define I2C_BUS_TIMEOUT_MIN_US 1000
+#endif
+
+// Pulsos de clock do bus clear (um byte + ACK)
+#define I2C_BUS_CLEAR_PULSES 9
+
+// Contas de i2c_bus_frame_us, i2c_bus_deadline_us e i2c_bus_worst_case_us
+// com a velocidade dada, para prazos conhecidos em tempo de compilação
+// (ex.: tabelas de lib/sensor_sched)
+#define I2C_BUS_FRAME_US(len, baudrate) \
+    ((uint32_t)(((uint64_t)(len) + 1u) * 9u * 1000000u / (baudrate)))
+#define I2C_BUS_DEADLINE_US(len, baudrate) \
+    (I2C_BUS_TIMEOUT_MIN_US + 2u * I2C_BUS_FRAME_US(len, baudrate))
+#define I2C_BUS_RECOVERY_US(baudrate) \
+    ((2u * I2C_BUS_CLEAR_PULSES + 4u) * (500000u / (baudrate) + 1u))
+#define I2C_BUS_WORST_CASE_US(len, baudrate) \
+    ((I2C_BUS_RETRIES + 1u) * (I2C_BUS_DEADLINE_US((len) + 1u, baudrate) + I2C_BUS_RECOVERY_US(baudrate)))
+
+typedef struct {
+    uint32_t transacoes;        // chamadas a i2c_bus_write/read
+    uint32_t erros;             // transações que falharam mesmo após as repetições
+    uint32_t nacks;             // tentativas sem ACK
+    uint32_t timeouts;          // tentativas que estouraram o prazo
+    uint32_t retentativas;
+    uint32_t recuperacoes;      // bus clears disparados por este dispositivo
+    uint32_t latencia_max_us;   // maior duração de uma transação (com repetições)
+    uint64_t latencia_total_us;
+} i2c_bus_stats_t;
+
+// Configura o barramento (pinos, pull-ups e velocidade) e guarda os pinos
+// para o bus clear
+void i2c_bus_init(i2c_inst_t *i2c, uint sda, uint scl, uint baudrate);
+
+// Mesmo contrato de i2c_write_blocking/i2c_read_blocking: bytes
+// transferidos ou PICO_ERROR_GENERIC/PICO_ERROR_TIMEOUT
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// Leitura de registrador: escrita + repeated start + leitura, repetidas
+// juntas (uma leitura repetida sozinha pegaria o ponteiro já avançado).
+// Retorna os bytes lidos ou erro.
+int i2c_bus_write_read(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t wlen, uint8_t *dst, size_t rlen);
+
+// Libera um escravo preso segurando SDA e reinicia o periférico
+void i2c_bus_recover(i2c_inst_t *i2c);
+
+// Duração no barramento de uma transação de len bytes (endereço incluso)
+uint32_t i2c_bus_frame_us(uint32_t len, uint baudrate);
+
+// Prazo de uma tentativa de len bytes e pior caso de uma transação com len
+// bytes escritos + lidos (repetições e bus clears incluídos)
+uint32_t i2c_bus_deadline_us(i2c_inst_t *i2c, size_t len);
+uint32_t i2c_bus_worst_case_us(i2c_inst_t *i2c, size_t len);
+
+// Contadores de um dispositivo; false se ele ainda não foi usado
+bool i2c_bus_get_stats(i2c_inst_t *i2c, uint8_t addr, i2c_bus_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+#include "impact.h"
+
+// |a|^2 de uma amostra; cabe em 32 bits (no máximo 3 * 2^30)
+static inline uint32_t mag2(const int16_t *a)
+{
+    int32_t x = a[0], y = a[1], z = a[2];
+    return (uint32_t)(x * x) + (uint32_t)(y * y) + (uint32_t)(z * z);
+}
+
+static uint32_t isqrt(uint32_t v)
+{
+    uint32_t res = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v) bit >>= 2;
+
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+void impact_init(impact_detector_t *d, float limiar_g, int32_t lsb_por_g)
+{
+    float limiar = limiar_g * (float)lsb_por_g;
+    float limiar2 = limiar * limiar;
+
+    d->limiar_mag2 = limiar2 >= 4294967295.0f ? UINT32_MAX : (uint32_t)limiar2;
+    d->lsb_por_g = lsb_por_g;
+    d->tem_anterior = false;
+}
+
+int32_t impact_scan(const impact_detector_t *d, const int16_t *xyz, size_t n)
+{
+    const uint32_t limiar = d->limiar_mag2;
+    size_t i = 0;
+
+    // Quatro amostras por volta: só multiplicações e comparações de 32 bits
+    for (; i + 4 <= n; i += 4, xyz += 12) {
+        uint32_t m0 = mag2(xyz);
+        uint32_t m1 = mag2(xyz + 3);
+        uint32_t m2 = mag2(xyz + 6);
+        uint32_t m3 = mag2(xyz + 9);
+
+        if ((m0 > limiar) | (m1 > limiar) | (m2 > limiar) | (m3 > limiar)) {
+            if (m0 > limiar) return (int32_t)i;
+            if (m1 > limiar) return (int32_t)i + 1;
+            if (m2 > limiar) return (int32_t)i + 2;
+            return (int32_t)i + 3;
+        }
+    }
+
+    for (; i < n; i++, xyz += 3) {
+        if (mag2(xyz) > limiar) return (int32_t)i;
+    }
+    return -1;
+}
+
+// Blocos de até 65535 amostras: as somas por eixo cabem em 64 bits
+void impact_process(impact_detector_t *d, const int16_t *xyz, size_t n, impact_features_t *f)
+{
+    const uint32_t limiar = d->limiar_mag2;
+    int64_t soma[3] = { 0, 0, 0 };
+    uint64_t soma2[3] = { 0, 0, 0 };
+    int32_t ax = d->anterior[0], ay = d->anterior[1], az = d->anterior[2];
+    bool tem_anterior = d->tem_anterior;
+
+    f->pico_mag2 = 0;
+    f->indice_pico = 0;
+    f->primeiro_acima = -1;
+    f->acima = 0;
+    f->energia = 0;
+    f->jerk_mag2 = 0;
+
+    if (n == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++, xyz += 3) {
+        int32_t x = xyz[0], y = xyz[1], z = xyz[2];
+        uint32_t x2 = (uint32_t)(x * x), y2 = (uint32_t)(y * y), z2 = (uint32_t)(z * z);
+        uint32_t m = x2 + y2 + z2;
+
+        if (m > f->pico_mag2) {
+            f->pico_mag2 = m;
+            f->indice_pico = (uint32_t)i;
+        }
+        if (m > limiar) {
+            if (f->primeiro_acima < 0) f->primeiro_acima = (int32_t)i;
+            f->acima++;
+        }
+
+        // Diferença entre amostras consecutivas: até 2^16 por eixo, 3 * 2^32 no total
+        if (tem_anterior) {
+            int32_t dx = x - ax, dy = y - ay, dz = z - az;
+            uint64_t j = (uint64_t)((uint32_t)dx * (uint32_t)dx) + (uint32_t)dy * (uint32_t)dy + (uint32_t)dz * (uint32_t)dz;
+            uint32_t j32 = j > UINT32_MAX ? UINT32_MAX : (uint32_t)j;
+            if (j32 > f->jerk_mag2) f->jerk_mag2 = j32;
+        }
+        ax = x;
+        ay = y;
+        az = z;
+        tem_anterior = true;
+
+        soma[0] += x;
+        soma[1] += y;
+        soma[2] += z;
+        soma2[0] += x2;
+        soma2[1] += y2;
+        soma2[2] += z2;
+    }
+
+    // Energia em torno da média: soma(a^2) - soma(a)^2 / n, por eixo
+    for (int k = 0; k < 3; k++) {
+        f->energia += soma2[k] - (uint64_t)(soma[k] * soma[k]) / n;
+    }
+
+    d->anterior[0] = (int16_t)ax;
+    d->anterior[1] = (int16_t)ay;
+    d->anterior[2] = (int16_t)az;
+    d->tem_anterior = true;
+}
+
+uint32_t impact_mag2_to_mg(const impact_detector_t *d, uint32_t mag2)
+{
+    return isqrt(mag2) * 1000u / (uint32_t)d->lsb_por_g;
+}
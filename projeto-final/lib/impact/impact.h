@@ -0,0 +1,43 @@
+#ifndef IMPACT_H
+#define IMPACT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Detecção de impacto sobre blocos de amostras brutas do acelerômetro.
+//
+// As amostras ficam intercaladas (x, y, z, x, y, z, ...), no formato da
+// leitura em rajada e da FIFO do MPU6050. Tudo é feito com inteiros: o
+// limiar é comparado com |a|^2, sem raiz quadrada nem float por amostra.
+
+typedef struct {
+    uint32_t limiar_mag2;   // limiar em LSB^2
+    int32_t lsb_por_g;
+    int16_t anterior[3];    // última amostra do bloco anterior (para o jerk)
+    bool tem_anterior;
+} impact_detector_t;
+
+// Características de um bloco
+typedef struct {
+    uint32_t pico_mag2;     // maior |a|^2 do bloco, em LSB^2
+    uint32_t indice_pico;
+    int32_t primeiro_acima; // índice da primeira amostra acima do limiar, ou -1
+    uint32_t acima;         // quantidade de amostras acima do limiar
+    uint64_t energia;       // soma de |a - média|^2 no bloco (remove a gravidade)
+    uint32_t jerk_mag2;     // maior |a[i] - a[i-1]|^2, em LSB^2
+} impact_features_t;
+
+// Prepara o detector; o limiar em g é convertido uma única vez
+void impact_init(impact_detector_t *d, float limiar_g, int32_t lsb_por_g);
+
+// Varredura rápida: índice da primeira amostra acima do limiar, ou -1
+int32_t impact_scan(const impact_detector_t *d, const int16_t *xyz, size_t n);
+
+// Varredura completa com pico, energia e jerk; atualiza a amostra anterior
+void impact_process(impact_detector_t *d, const int16_t *xyz, size_t n, impact_features_t *f);
+
+// Converte |a|^2 em LSB^2 para mili-g (raiz inteira, para exibição)
+uint32_t impact_mag2_to_mg(const impact_detector_t *d, uint32_t mag2);
+
+#endif
@@ -0,0 +1,119 @@
+#include "motion_irq.h"
+
+#ifndef MOTION_IRQ_SIMULADO
+#include "hardware/gpio.h"
+#endif
+
+#if TRACE_RECORDER
+#include "trace.h"
+#endif
+
+// Task acordada pelo pino INT
+static TaskHandle_t xMotionTask = NULL;
+static uint motion_gpio;
+
+static volatile uint32_t eventos = 0;
+static uint32_t eventos_lidos = 0;
+static motion_irq_stats_t stats;
+
+#if TRACE_RECORDER
+static uint16_t trace_id;
+#endif
+
+#ifndef MOTION_IRQ_SIMULADO
+static void motion_irq_callback(uint gpio, uint32_t events)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (gpio != motion_gpio || xMotionTask == NULL) {
+        return;
+    }
+
+#if TRACE_RECORDER
+    trace_isr_enter(trace_id);
+#endif
+    eventos++;
+    vTaskNotifyGiveFromISR(xMotionTask, &woken);
+#if TRACE_RECORDER
+    trace_isr_exit(trace_id);
+#endif
+    portYIELD_FROM_ISR(woken);
+}
+#endif
+
+bool motion_irq_init(uint gpio)
+{
+    xMotionTask = xTaskGetCurrentTaskHandle();
+    motion_gpio = gpio;
+#if TRACE_RECORDER
+    trace_id = trace_registra(TRACE_OBJ_ISR, "MPU INT");
+#endif
+
+#ifndef MOTION_IRQ_SIMULADO
+    // INT em dreno aberto: precisa de pull-up
+    gpio_init(gpio);
+    gpio_set_dir(gpio, GPIO_IN);
+    gpio_pull_up(gpio);
+    gpio_set_irq_enabled_with_callback(gpio, GPIO_IRQ_EDGE_FALL, true, motion_irq_callback);
+
+    // Pino já travado em nível baixo: a borda foi perdida antes do init
+    if (!gpio_get(gpio)) {
+        eventos++;
+        xTaskNotifyGive(xMotionTask);
+    }
+#endif
+    return xMotionTask != NULL;
+}
+
+void motion_irq_simulate(void)
+{
+    if (xMotionTask != NULL) {
+        eventos++;
+        xTaskNotifyGive(xMotionTask);
+    }
+}
+
+bool motion_irq_pending(void)
+{
+    uint32_t atual = eventos;
+
+    if (atual == eventos_lidos) {
+        return false;
+    }
+    eventos_lidos = atual;
+    return true;
+}
+
+bool motion_irq_read(mpu6050_dev_t *dev, int16_t *xyz, size_t n)
+{
+    mpu6050_sample_t amostra;
+
+    // A primeira leitura libera a trava do pino INT; se o movimento
+    // continuar, uma nova borda agenda a próxima captura
+    if (n == 0) {
+        mpu6050_read_int_status(dev);
+    }
+    if (!mpu6050_read(dev, &amostra)) {
+        stats.falhas++;
+        return false;
+    }
+
+    xyz[3 * n + 0] = amostra.accel_raw[0];
+    xyz[3 * n + 1] = amostra.accel_raw[1];
+    xyz[3 * n + 2] = amostra.accel_raw[2];
+    return true;
+}
+
+void motion_irq_capture_end(size_t n)
+{
+    if (n > 0) {
+        stats.capturas++;
+        stats.amostras += n;
+    }
+}
+
+void motion_irq_get_stats(motion_irq_stats_t *out)
+{
+    *out = stats;
+    out->eventos = eventos;
+}
@@ -0,0 +1,40 @@
+#ifndef MOTION_IRQ_H
+#define MOTION_IRQ_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mpu_wrapper.h"
+
+// Acorda uma task pelo pino INT do MPU6050 (detecção de movimento feita no
+// próprio sensor). Com MOTION_IRQ_SIMULADO definido não há GPIO: os eventos
+// vêm de motion_irq_simulate, o que permite rodar no port Posix do FreeRTOS.
+
+typedef struct {
+    uint32_t eventos;    // bordas no pino INT (ou eventos simulados)
+    uint32_t capturas;   // janelas de amostras lidas
+    uint32_t amostras;   // amostras lidas no total
+    uint32_t falhas;     // leituras I2C com erro durante a captura
+} motion_irq_stats_t;
+
+// Liga o pino INT (ativo em nível baixo) à task que chama esta função
+bool motion_irq_init(uint gpio);
+
+// Fonte simulada: mesmo efeito de uma borda no pino, chamada de uma task
+void motion_irq_simulate(void);
+
+// Captura em passos, sem bloquear (lib/sensor_sched, lib/colisao):
+// motion_irq_pending consome um evento sem esperar; motion_irq_read lê a
+// amostra n (x, y, z brutos intercalados; n == 0 libera a trava do INT) com
+// o mutex do barramento já tomado; motion_irq_capture_end contabiliza a
+// janela de n amostras.
+bool motion_irq_pending(void);
+bool motion_irq_read(mpu6050_dev_t *dev, int16_t *xyz, size_t n);
+void motion_irq_capture_end(size_t n);
+
+void motion_irq_get_stats(motion_irq_stats_t *stats);
+
+#endif
@@ -1,29 +1,139 @@
+#include <new>
+
 #include "mpu_wrapper.h"
 #include "MPU6050.h"
 
-// Instância global do objeto C++
-MPU6050 *mpu = nullptr;
+// Instância de um sensor; o objeto C++ é construído no próprio slot
+struct mpu6050_dev {
+    alignas(MPU6050) uint8_t storage[sizeof(MPU6050)];
+    MPU6050 *mpu;
+    i2c_inst_t *i2c;
+    uint8_t addr;
+};
+
+static mpu6050_dev_t sensores[MPU6050_MAX_SENSORES];
+static size_t sensores_abertos = 0;
+
+// Copia a amostra do driver para a estrutura C
+static void copy_sample(mpu6050_sample_t *sample, const MPU6050::Sample &s) {
+    sample->timestamp_us = s.timestamp_us;
+    for (int i = 0; i < 3; i++) {
+        sample->accel_raw[i] = s.accel_raw[i];
+        sample->gyro_raw[i] = s.gyro_raw[i];
+    }
+    sample->temp_raw = s.temp_raw;
+    sample->accel[0] = s.accel.x;
+    sample->accel[1] = s.accel.y;
+    sample->accel[2] = s.accel.z;
+    sample->gyro[0] = s.gyro.x;
+    sample->gyro[1] = s.gyro.y;
+    sample->gyro[2] = s.gyro.z;
+    sample->temp = s.temp;
+}
+
+// Abre (ou reabre) um sensor
+mpu6050_dev_t *mpu6050_open(i2c_inst_t *i2c, uint8_t addr) {
+    mpu6050_dev_t *dev = nullptr;
+
+    for (size_t i = 0; i < sensores_abertos; i++) {
+        if (sensores[i].i2c == i2c && sensores[i].addr == addr) {
+            dev = &sensores[i];
+            break;
+        }
+    }
+
+    if (dev == nullptr) {
+        if (sensores_abertos >= MPU6050_MAX_SENSORES) {
+            return nullptr;
+        }
+        dev = &sensores[sensores_abertos];
+        dev->mpu = new (dev->storage) MPU6050(i2c, addr);
+        dev->i2c = i2c;
+        dev->addr = addr;
+    }
+
+    if (!dev->mpu->begin()) {
+        return nullptr;
+    }
+
+    // Só ocupa o slot depois que o sensor respondeu
+    if (dev == &sensores[sensores_abertos]) {
+        sensores_abertos++;
+    }
+    return dev;
+}
+
+// Leitura completa (uma única transação I2C)
+bool mpu6050_read(mpu6050_dev_t *dev, mpu6050_sample_t *sample) {
+    MPU6050::Sample s;
+
+    if (dev == nullptr || !dev->mpu->read(s)) {
+        return false;
+    }
+
+    copy_sample(sample, s);
+    return true;
+}
+
+// Leitura de todos os sensores abertos
+size_t mpu6050_read_all(mpu6050_sample_t *samples, bool *ok, size_t max) {
+    size_t n = sensores_abertos < max ? sensores_abertos : max;
+
+    for (size_t i = 0; i < n; i++) {
+        ok[i] = mpu6050_read(&sensores[i], &samples[i]);
+    }
+    return n;
+}
+
+size_t mpu6050_count(void) {
+    return sensores_abertos;
+}
+
+// Liga a interrupção de movimento mantendo faixa e filtros atuais
+bool mpu6050_enable_motion(mpu6050_dev_t *dev, uint16_t limiar_mg, uint8_t duracao_ms) {
+    if (dev == nullptr) {
+        return false;
+    }
+
+    MPU6050::Config cfg = dev->mpu->getConfig();
+    uint16_t limiar = limiar_mg / 2;     // 2 mg por LSB
+
+    cfg.accelHpf = MPU6050::AccelHpf::HZ5;
+    cfg.motionThreshold = limiar > 255 ? 255 : (limiar == 0 ? 1 : (uint8_t)limiar);
+    cfg.motionDuration = duracao_ms == 0 ? 1 : duracao_ms;
+    cfg.intPinCfg = MPU6050::INT_ACTIVE_LOW | MPU6050::INT_OPEN_DRAIN | MPU6050::INT_LATCH;
+    cfg.intEnable |= MPU6050::INT_MOTION;
+    return dev->mpu->configure(cfg);
+}
+
+// Status de interrupção
+int mpu6050_read_int_status(mpu6050_dev_t *dev) {
+    if (dev == nullptr) {
+        return -1;
+    }
+    return dev->mpu->readIntStatus();
+}
 
 // Função de inicialização
 void mpu6050_init_c(i2c_inst_t *i2c, uint8_t addr) {
-    if (mpu == nullptr) {
-        mpu = new MPU6050(i2c, addr);
-    }
-    mpu->begin();
+    mpu6050_open(i2c, addr);
 }
 
 // Função de leitura de aceleração
-void mpu6050_read_accel_c(float *x, float *y, float *z) {
-    if (mpu != nullptr) {
-        // --- CORREÇÃO AQUI ---
-        // Usamos MPU6050::VECT_3D para dizer que a struct pertence à classe
-        MPU6050::VECT_3D v; 
-        
-        // 16384.0f é a escala padrão para +/- 2g
-        mpu->getAccel(&v, 16384.0f);
-        
-        *x = v.x;
-        *y = v.y;
-        *z = v.z;
-    }
-}
\ No newline at end of file
+bool mpu6050_read_accel_c(float *x, float *y, float *z) {
+    mpu6050_sample_t s;
+
+    if (sensores_abertos == 0 || !mpu6050_read(&sensores[0], &s)) {
+        return false;
+    }
+
+    *x = s.accel[0];
+    *y = s.accel[1];
+    *z = s.accel[2];
+    return true;
+}
+
+// Função de leitura completa
+bool mpu6050_read_sample_c(mpu6050_sample_t *sample) {
+    return sensores_abertos > 0 && mpu6050_read(&sensores[0], sample);
+}
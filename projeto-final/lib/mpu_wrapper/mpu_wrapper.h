@@ -1,6 +1,7 @@
 #ifndef MPU_WRAPPER_H
 #define MPU_WRAPPER_H
 
+#include <stddef.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 
@@ -8,12 +9,54 @@
 extern "C" {
 #endif
 
-// Funções acessíveis pelo C
+// Sensores simultâneos: 0x68 e 0x69 em cada um dos dois barramentos
+#ifndef MPU6050_MAX_SENSORES
+#define MPU6050_MAX_SENSORES 4
+#endif
+
+// Amostra de uma leitura em rajada (mesmo conteúdo de MPU6050::Sample)
+typedef struct {
+    uint64_t timestamp_us;
+    int16_t accel_raw[3];
+    int16_t temp_raw;
+    int16_t gyro_raw[3];
+    float accel[3];     // g
+    float gyro[3];      // graus por segundo
+    float temp;         // C
+} mpu6050_sample_t;
+
+// Handle de um sensor; as instâncias são estáticas (sem heap)
+typedef struct mpu6050_dev mpu6050_dev_t;
+
+// Inicia o sensor no barramento/endereço e devolve o handle,
+// ou NULL se não houver instância livre ou o sensor não responder
+mpu6050_dev_t *mpu6050_open(i2c_inst_t *i2c, uint8_t addr);
+
+// Leitura em rajada de um sensor
+bool mpu6050_read(mpu6050_dev_t *dev, mpu6050_sample_t *sample);
+
+// Leitura em lote: uma rajada por sensor aberto, na ordem de abertura.
+// ok[i] indica o sucesso de cada leitura. Retorna quantos foram lidos.
+size_t mpu6050_read_all(mpu6050_sample_t *samples, bool *ok, size_t max);
+
+// Quantidade de sensores abertos
+size_t mpu6050_count(void);
+
+// Detecção de movimento feita pelo próprio sensor: o pino INT vai a nível
+// baixo (dreno aberto, travado) quando a aceleração filtrada pelo passa-altas
+// passa de limiar_mg por duracao_ms. A trava é liberada por mpu6050_read_int_status.
+bool mpu6050_enable_motion(mpu6050_dev_t *dev, uint16_t limiar_mg, uint8_t duracao_ms);
+
+// Lê e limpa o status de interrupção; -1 em erro
+int mpu6050_read_int_status(mpu6050_dev_t *dev);
+
+// Interface antiga, sobre o primeiro sensor aberto
 void mpu6050_init_c(i2c_inst_t *i2c, uint8_t addr);
-void mpu6050_read_accel_c(float *x, float *y, float *z);
+bool mpu6050_read_accel_c(float *x, float *y, float *z);
+bool mpu6050_read_sample_c(mpu6050_sample_t *sample);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif
\ No newline at end of file
+#endif
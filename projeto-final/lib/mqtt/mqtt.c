@@ -1,4 +1,7 @@
 #include "mqtt.h"
+#include "dlog.h"
+#include "task_stacks.h"
+#include "task_affinity.h"
 
 //===============================
 // Configurações MQTT
@@ -13,10 +16,16 @@
 //===============================
 static mqtt_client_t *mqtt_client;
 static ip_addr_t broker_ip;
-static bool mqtt_connected = false;
+// Escrito pelo callback de conexão, no contexto do lwIP
+static volatile bool mqtt_connected = false;
 
 static QueueHandle_t mqttQueue = NULL;
 
+// Toda chamada ao lwIP feita de uma task fica entre cyw43_arch_lwip_begin
+// e cyw43_arch_lwip_end: no modo threadsafe_background o lwIP roda na
+// interrupção do CYW43, que pode estar no outro núcleo. Os callbacks
+// (DNS e conexão) já rodam nesse contexto.
+
 // Forward declarations
 static void mqtt_task(void *pv);
 static void mqtt_dns_callback(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
@@ -27,7 +36,9 @@ static void mqtt_connection_cb(mqtt_client_t *client, void *arg, mqtt_connection
 //                Inicialização do MQTT
 //=========================================================
 void mqtt_start() {
+    cyw43_arch_lwip_begin();
     mqtt_client = mqtt_client_new();
+    cyw43_arch_lwip_end();
     if (!mqtt_client) {
         printf("[MQTT] ERRO: mqtt_client_new() retornou NULL!\n");
         return;
@@ -38,8 +49,9 @@ void mqtt_start() {
         printf("[MQTT] ERRO: Falha ao criar fila MQTT!\n");
         return;
     }
+    vQueueAddToRegistry(mqttQueue, "mqtt");
 
-    xTaskCreate(mqtt_task, "MQTT_Task", 4096, NULL, 1, NULL);
+    task_affinity_create(mqtt_task, "MQTT_Task", PILHA_MQTT_TASK, NULL, 1, AFINIDADE_MQTT_TASK, NULL);
 }
 
 bool mqtt_is_connected() {
@@ -55,6 +67,7 @@ void mqtt_publish_async(const char *topic, const char *payload) {
 
     snprintf(msg.topic, sizeof(msg.topic), "%s", topic);
     snprintf(msg.payload, sizeof(msg.payload), "%s", payload);
+    msg.topic_log = topic;
 
     if (mqttQueue != NULL) {
         xQueueSend(mqttQueue, &msg, 0);
@@ -125,6 +138,7 @@ static void mqtt_task(void *pv) {
         if (!mqtt_connected) {
             printf("[MQTT] Resolvendo DNS...\n");
 
+            cyw43_arch_lwip_begin();
             err_t err = dns_gethostbyname(
                 MQTT_BROKER,
                 &broker_ip,
@@ -132,9 +146,11 @@ static void mqtt_task(void *pv) {
                 NULL
             );
 
+            // Resolvido na hora: o callback (e o connect) roda aqui mesmo
             if (err == ERR_OK) {
                 mqtt_dns_callback(MQTT_BROKER, &broker_ip, NULL);
             }
+            cyw43_arch_lwip_end();
 
             vTaskDelay(pdMS_TO_TICKS(5000));
         }
@@ -149,6 +165,7 @@ static void mqtt_task(void *pv) {
             // Bloqueia até 1s por mensagem
             if (xQueueReceive(mqttQueue, &msg, pdMS_TO_TICKS(1000))) {
 
+                cyw43_arch_lwip_begin();
                 err_t pub_err = mqtt_publish(
                     mqtt_client,
                     msg.topic,
@@ -159,13 +176,16 @@ static void mqtt_task(void *pv) {
                     NULL,
                     NULL
                 );
+                cyw43_arch_lwip_end();
 
                 if (pub_err == ERR_OK) {
-                    printf("[MQTT] Enviado: %s -> %s\n",
-                           msg.topic,
-                           msg.payload);
+                    // O buffer da fila não sobrevive até o flush do log:
+                    // vai o tamanho do payload e o tópico constante do chamador
+                    DLOG("[MQTT] Enviado: %u bytes em %s\n",
+                         (unsigned)strlen(msg.payload),
+                         msg.topic_log);
                 } else {
-                    printf("[MQTT] Erro ao publicar: %d\n", pub_err);
+                    DLOG("[MQTT] Erro ao publicar: %d\n", (int)pub_err);
                 }
             }
         }
@@ -16,10 +16,12 @@
 typedef struct {
     char topic[128];
     char payload[256];
+    const char *topic_log;  // ponteiro do chamador, para o log adiado
 } mqtt_message_t;
 
 void mqtt_start();
 bool mqtt_is_connected();
+// topic deve ser uma string constante: o log do envio guarda o ponteiro
 void mqtt_publish_async(const char *topic, const char *payload);
 
 #endif
\ No newline at end of file
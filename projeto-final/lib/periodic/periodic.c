@@ -0,0 +1,180 @@
+#include "periodic.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+static periodic_t *registradas[PERIODIC_MAX];
+static size_t n_registradas;
+
+static void registra(periodic_t *p) {
+    for (size_t i = 0; i < n_registradas; i++) {
+        if (registradas[i] == p) {
+            return;
+        }
+    }
+    taskENTER_CRITICAL();
+    if (n_registradas < PERIODIC_MAX) {
+        registradas[n_registradas++] = p;
+    }
+    taskEXIT_CRITICAL();
+}
+
+// Último tick e o instante em que aconteceu, gravados na interrupção
+static volatile uint32_t tick_atual;
+static volatile uint32_t tick_atual_us;
+
+void periodic_tick(uint32_t tick) {
+    tick_atual_us = time_us_32();
+    tick_atual = tick;
+}
+
+static unsigned faixa(uint32_t us) {
+    unsigned k = 0;
+
+    while (k < PERIODIC_FAIXAS - 1 && us >= (PERIODIC_FAIXA_BASE_US << k)) {
+        k++;
+    }
+    return k;
+}
+
+void periodic_init(periodic_t *p, const char *nome, uint32_t periodo_ms, uint32_t prazo_ms) {
+    memset(p, 0, sizeof(*p));
+    p->nome = nome;
+    periodic_set_period(p, periodo_ms);
+    p->prazo_us = (prazo_ms != 0) ? prazo_ms * 1000u : p->periodo_us;
+    registra(p);
+}
+
+void periodic_set_period(periodic_t *p, uint32_t periodo_ms) {
+    TickType_t ticks = pdMS_TO_TICKS(periodo_ms);
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    uint32_t periodo_us = (uint32_t)ticks * portTICK_PERIOD_MS * 1000u;
+    if (p->prazo_us == p->periodo_us) {
+        p->prazo_us = periodo_us;
+    }
+    p->periodo_ticks = ticks;
+    p->periodo_us = periodo_us;
+}
+
+uint32_t periodic_tick_us(TickType_t tick) {
+    taskENTER_CRITICAL();
+    uint32_t atual = tick_atual;
+    uint32_t atual_us = tick_atual_us;
+    taskEXIT_CRITICAL();
+
+    return atual_us - (atual - (uint32_t)tick) * (portTICK_PERIOD_MS * 1000u);
+}
+
+// Início de uma ativação: jitter desde a liberação
+static void conta_inicio(periodic_t *p, uint32_t liberacao_us, uint32_t inicio_us) {
+    uint32_t jitter = inicio_us - liberacao_us;
+
+    p->liberacao_us = liberacao_us;
+    p->inicio_us = inicio_us;
+    if (jitter > p->stats.jitter_max_us) {
+        p->stats.jitter_max_us = jitter;
+    }
+    p->stats.hist_jitter[faixa(jitter)]++;
+    p->stats.ativacoes++;
+}
+
+// Fim de uma ativação: tempo de execução e prazo
+static void conta_fim(periodic_t *p, uint32_t fim_us) {
+    uint32_t exec = fim_us - p->inicio_us;
+
+    if (exec > p->stats.exec_max_us) {
+        p->stats.exec_max_us = exec;
+    }
+    p->stats.hist_exec[faixa(exec)]++;
+    if (fim_us - p->liberacao_us > p->prazo_us) {
+        p->stats.perdas_prazo++;
+    }
+}
+
+void periodic_record(periodic_t *p, uint32_t liberacao_us, uint32_t inicio_us, uint32_t fim_us,
+                     uint32_t puladas) {
+    p->stats.puladas += puladas;
+    conta_inicio(p, liberacao_us, inicio_us);
+    conta_fim(p, fim_us);
+}
+
+void periodic_wait(periodic_t *p) {
+    if (p->iniciada) {
+        conta_fim(p, time_us_32());
+
+        // Liberações que já passaram inteiras são descartadas: a próxima é
+        // a primeira ainda no futuro
+        TickType_t tick = xTaskGetTickCount();
+        while ((TickType_t)(tick - p->ultimo) >= p->periodo_ticks) {
+            p->ultimo += p->periodo_ticks;
+            p->stats.puladas++;
+        }
+    } else {
+        // Primeira liberação um período depois do tick atual
+        p->ultimo = xTaskGetTickCount();
+        p->iniciada = true;
+    }
+
+    xTaskDelayUntil(&p->ultimo, p->periodo_ticks);
+
+    // p->ultimo é agora o tick da liberação; o jitter é o tempo desde ele
+    uint32_t inicio = time_us_32();
+    conta_inicio(p, periodic_tick_us(p->ultimo), inicio);
+}
+
+void periodic_get_stats(const periodic_t *p, periodic_stats_t *stats) {
+    taskENTER_CRITICAL();
+    *stats = p->stats;
+    taskEXIT_CRITICAL();
+}
+
+void periodic_reset_stats(void) {
+    for (size_t i = 0; i < n_registradas; i++) {
+        taskENTER_CRITICAL();
+        memset(&registradas[i]->stats, 0, sizeof(registradas[i]->stats));
+        taskEXIT_CRITICAL();
+    }
+}
+
+size_t periodic_count(void) {
+    return n_registradas;
+}
+
+const periodic_t *periodic_get(size_t i) {
+    return i < n_registradas ? registradas[i] : NULL;
+}
+
+size_t periodic_format_json(char *buf, size_t len) {
+    size_t n = 0;
+
+    if (len < 3) {
+        return 0;
+    }
+    buf[n++] = '[';
+
+    for (size_t i = 0; i < n_registradas; i++) {
+        const periodic_t *p = registradas[i];
+        periodic_stats_t st;
+        char item[96];
+
+        periodic_get_stats(p, &st);
+        int w = snprintf(item, sizeof(item), "%s[\"%s\",%lu,%lu,%lu,%lu,%lu,%lu]", i ? "," : "", p->nome,
+                         (unsigned long)(p->periodo_us / 1000u), (unsigned long)st.ativacoes,
+                         (unsigned long)st.perdas_prazo, (unsigned long)st.puladas,
+                         (unsigned long)st.jitter_max_us, (unsigned long)st.exec_max_us);
+        if (w < 0 || n + (size_t)w + 2 > len) {
+            break;
+        }
+        memcpy(buf + n, item, (size_t)w);
+        n += (size_t)w;
+    }
+
+    buf[n++] = ']';
+    buf[n] = '\0';
+    return n;
+}
@@ -0,0 +1,90 @@
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Tarefas periódicas com ativações em instantes fixos (xTaskDelayUntil):
+// o período não escorrega com o tempo gasto em cada ativação.
+//
+//     periodic_init(&per, "AHT10", 2000, 0);
+//     while (true) {
+//         periodic_wait(&per);
+//         ... trabalho ...
+//     }
+//
+// periodic_wait encerra a ativação anterior (tempo de execução e prazo) e
+// espera a próxima liberação; o atraso entre o tick da liberação e o
+// instante em que a task voltou a executar é o jitter. O instante do tick
+// vem do hook traceTASK_INCREMENT_TICK (periodic_hooks.h), para que a
+// medida não acumule a diferença entre o tick e o relógio em us. Os dois
+// vão para histogramas de potências de 2 em us. Ativações perdidas depois
+// de um estouro longo são puladas (sem rajada para recuperar) e contadas.
+
+// Histogramas: faixa k cobre [64 * 2^(k-1), 64 * 2^k) us; a 0 é < 64 us e
+// a última acumula o resto (>= 8,2 ms)
+#define PERIODIC_FAIXAS 9
+#define PERIODIC_FAIXA_BASE_US 64u
+
+// Tarefas periódicas visíveis ao diagnóstico
+#define PERIODIC_MAX 8
+
+typedef struct {
+    uint32_t ativacoes;
+    uint32_t perdas_prazo;      // ativação terminou depois do prazo
+    uint32_t puladas;           // liberações descartadas após um estouro
+    uint32_t jitter_max_us;
+    uint32_t exec_max_us;
+    uint32_t hist_jitter[PERIODIC_FAIXAS];
+    uint32_t hist_exec[PERIODIC_FAIXAS];
+} periodic_stats_t;
+
+typedef struct {
+    const char *nome;
+    uint32_t periodo_us;
+    uint32_t prazo_us;          // relativo à liberação
+    TickType_t periodo_ticks;
+    TickType_t ultimo;          // referência do xTaskDelayUntil
+    uint32_t liberacao_us;      // tick que liberou a ativação atual
+    uint32_t inicio_us;         // instante em que a ativação começou
+    bool iniciada;
+    periodic_stats_t stats;
+} periodic_t;
+
+// Período em ms (múltiplo do tick); prazo 0 usa o período
+void periodic_init(periodic_t *p, const char *nome, uint32_t periodo_ms, uint32_t prazo_ms);
+
+// Troca o período a partir da próxima liberação (ex.: tempo de conversão
+// do sensor mudou); o prazo acompanha se era igual ao período
+void periodic_set_period(periodic_t *p, uint32_t periodo_ms);
+
+// Fim da ativação atual e espera pela próxima
+void periodic_wait(periodic_t *p);
+
+// Ativação de um executor próprio, que não usa periodic_wait (ex.:
+// lib/sensor_sched): instantes em time_us_32 e liberações puladas antes dela
+void periodic_record(periodic_t *p, uint32_t liberacao_us, uint32_t inicio_us, uint32_t fim_us,
+                     uint32_t puladas);
+
+// Instante (time_us_32) em que a contagem de ticks chegou a 'tick' (passado)
+uint32_t periodic_tick_us(TickType_t tick);
+
+// Cópia consistente das estatísticas
+void periodic_get_stats(const periodic_t *p, periodic_stats_t *stats);
+
+// Zera as estatísticas de todas as tasks registradas (início de uma
+// janela de medida)
+void periodic_reset_stats(void);
+
+// Tarefas registradas (na ordem do periodic_init)
+size_t periodic_count(void);
+const periodic_t *periodic_get(size_t i);
+
+// [["nome",período ms,ativações,perdas,puladas,jitter máx us,exec máx us],...]
+size_t periodic_format_json(char *buf, size_t len);
+
+#endif
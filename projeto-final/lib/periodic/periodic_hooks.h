@@ -0,0 +1,14 @@
+#ifndef PERIODIC_HOOKS_H
+#define PERIODIC_HOOKS_H
+
+// Instante de cada tick para o jitter de lib/periodic. Incluído no fim do
+// FreeRTOSConfig.h; a macro é expandida em xTaskIncrementTick, antes do
+// incremento, e recebe o valor atual da contagem.
+
+#include <stdint.h>
+
+void periodic_tick(uint32_t tick);
+
+#define PERIODIC_TASK_INCREMENT_TICK(x) periodic_tick((uint32_t)(x) + 1u)
+
+#endif
@@ -0,0 +1,281 @@
+#include "sensor_sched.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "periodic.h"
+#include "task_stacks.h"
+#include "task_affinity.h"
+
+typedef enum {
+    FASE_OCIOSO,
+    FASE_INICIAR,
+    FASE_BUSCAR,
+    FASE_PRONTO,        // falta o decode
+} fase_t;
+
+typedef struct {
+    fase_t fase;
+    TickType_t periodo;
+    TickType_t prazo;
+    TickType_t liberacao;   // tick da liberação atual (ou da última)
+    TickType_t quando;      // próximo passo
+    uint32_t liberacao_us;  // instante do tick da liberação
+    uint32_t inicio_us;     // primeiro passo do ciclo atual
+    bool em_curso;
+    uint32_t puladas;
+    periodic_t per;
+} estado_t;
+
+static const sensor_desc_t *tabela;
+static size_t n_sensores;
+static SemaphoreHandle_t barramentos[SENSOR_SCHED_BARRAMENTOS];
+static size_t n_barramentos;
+static estado_t estados[SENSOR_SCHED_MAX];
+static sensor_sched_stats_t stats;
+
+// Diferença com sinal entre ticks (contagem circular)
+static inline int32_t ticks_ate(TickType_t t, TickType_t agora) {
+    return (int32_t)(t - agora);
+}
+
+static TickType_t ms_para_ticks(uint32_t ms) {
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    return ticks != 0 ? ticks : 1;
+}
+
+void sensor_sched_set_period(size_t id, uint32_t periodo_ms) {
+    if (id >= n_sensores || periodo_ms == 0) {
+        return;
+    }
+    estado_t *st = &estados[id];
+    TickType_t periodo = ms_para_ticks(periodo_ms);
+
+    if (st->prazo == st->periodo) {
+        st->prazo = periodo;
+    }
+    st->periodo = periodo;
+    periodic_set_period(&st->per, periodo_ms);
+}
+
+void sensor_sched_get_stats(sensor_sched_stats_t *out) {
+    taskENTER_CRITICAL();
+    *out = stats;
+    taskEXIT_CRITICAL();
+}
+
+static bool toma(uint8_t barramento, TickType_t espera) {
+    SemaphoreHandle_t mutex = barramentos[barramento];
+    return mutex == NULL || xSemaphoreTake(mutex, espera) == pdTRUE;
+}
+
+static void solta(uint8_t barramento) {
+    if (barramentos[barramento] != NULL) {
+        xSemaphoreGive(barramentos[barramento]);
+    }
+}
+
+// Sensores ociosos com evento ou com o período vencido passam a ter um
+// ciclo de leitura pendente
+static void libera(TickType_t agora) {
+    for (size_t i = 0; i < n_sensores; i++) {
+        const sensor_desc_t *d = &tabela[i];
+        estado_t *st = &estados[i];
+
+        if (st->fase != FASE_OCIOSO) {
+            continue;
+        }
+
+        if (d->evento != NULL && d->evento(d->ctx)) {
+            st->liberacao = agora;
+        } else if (d->periodo_ms != 0 && ticks_ate(st->liberacao + st->periodo, agora) <= 0) {
+            // Liberações que já passaram inteiras são puladas
+            TickType_t atraso = agora - st->liberacao;
+            TickType_t k = atraso / st->periodo;
+            st->puladas += k - 1;
+            st->liberacao += k * st->periodo;
+        } else {
+            continue;
+        }
+
+        st->fase = (d->start != NULL) ? FASE_INICIAR : FASE_BUSCAR;
+        st->quando = st->liberacao;
+        st->liberacao_us = periodic_tick_us(st->liberacao);
+        st->em_curso = false;
+    }
+}
+
+// Um passo (start ou fetch) do sensor i, seguido dos que não pedem espera
+static void passo(size_t i) {
+    const sensor_desc_t *d = &tabela[i];
+    estado_t *st = &estados[i];
+    sensor_passo_t r;
+    uint32_t espera_ms;
+
+    if (!st->em_curso) {
+        st->inicio_us = time_us_32();
+        st->em_curso = true;
+    }
+
+    do {
+        espera_ms = 0;
+        stats.passos++;
+        if (st->fase == FASE_INICIAR) {
+            r = d->start(d->ctx, &espera_ms);
+        } else {
+            r = d->fetch(d->ctx, &espera_ms);
+        }
+        if (r == SENSOR_AGUARDA) {
+            configASSERT(d->fetch != NULL);
+            st->fase = FASE_BUSCAR;
+        }
+    } while (r == SENSOR_AGUARDA && espera_ms == 0);
+
+    if (r == SENSOR_AGUARDA) {
+        st->quando = xTaskGetTickCount() + ms_para_ticks(espera_ms);
+    } else if (r == SENSOR_PRONTO) {
+        st->fase = FASE_PRONTO;
+    } else {
+        stats.erros++;
+        st->fase = FASE_OCIOSO;
+    }
+}
+
+// Passos vencidos de um barramento, em uma única tomada do mutex, na ordem
+// do prazo absoluto; os decodes ficam para depois de soltar o barramento
+static void executa_barramento(uint8_t b, TickType_t agora) {
+    size_t fila[SENSOR_SCHED_MAX];
+    size_t n = 0;
+
+    for (size_t i = 0; i < n_sensores; i++) {
+        estado_t *st = &estados[i];
+
+        if (tabela[i].barramento != b || (st->fase != FASE_INICIAR && st->fase != FASE_BUSCAR) ||
+            ticks_ate(st->quando, agora) > 0) {
+            continue;
+        }
+
+        // Inserção por prazo (poucos sensores)
+        TickType_t prazo = st->liberacao + st->prazo;
+        size_t j = n++;
+        while (j > 0 && ticks_ate(estados[fila[j - 1]].liberacao + estados[fila[j - 1]].prazo, prazo) > 0) {
+            fila[j] = fila[j - 1];
+            j--;
+        }
+        fila[j] = i;
+    }
+
+    if (n == 0 || !toma(b, pdMS_TO_TICKS(SENSOR_SCHED_ESPERA_MS))) {
+        return;
+    }
+    stats.lotes++;
+    for (size_t k = 0; k < n; k++) {
+        passo(fila[k]);
+    }
+    solta(b);
+
+    for (size_t k = 0; k < n; k++) {
+        const sensor_desc_t *d = &tabela[fila[k]];
+        estado_t *st = &estados[fila[k]];
+
+        if (st->fase != FASE_PRONTO) {
+            continue;
+        }
+        d->decode(d->ctx);
+        periodic_record(&st->per, st->liberacao_us, st->inicio_us, time_us_32(), st->puladas);
+        st->puladas = 0;
+        st->fase = FASE_OCIOSO;
+    }
+}
+
+// Ticks até o próximo passo ou liberação
+static TickType_t proxima(TickType_t agora) {
+    TickType_t espera = portMAX_DELAY;
+
+    for (size_t i = 0; i < n_sensores; i++) {
+        const estado_t *st = &estados[i];
+        int32_t ate;
+
+        if (st->fase == FASE_OCIOSO) {
+            if (tabela[i].periodo_ms == 0) {
+                continue;
+            }
+            ate = ticks_ate(st->liberacao + st->periodo, agora);
+        } else {
+            ate = ticks_ate(st->quando, agora);
+        }
+        if (ate <= 0) {
+            return 0;
+        }
+        if ((TickType_t)ate < espera) {
+            espera = (TickType_t)ate;
+        }
+    }
+    return espera;
+}
+
+static void sensor_sched_task(void *pv) {
+    (void)pv;
+
+    for (size_t i = 0; i < n_sensores; i++) {
+        const sensor_desc_t *d = &tabela[i];
+
+        if (d->init != NULL && toma(d->barramento, portMAX_DELAY)) {
+            if (!d->init(d->ctx)) {
+                printf("[sensores] %s: falha no init\n", d->nome);
+            }
+            solta(d->barramento);
+        }
+    }
+
+    // Primeira liberação de cada sensor logo em seguida
+    TickType_t agora = xTaskGetTickCount();
+    for (size_t i = 0; i < n_sensores; i++) {
+        estados[i].liberacao = agora - estados[i].periodo;
+    }
+
+    while (true) {
+        agora = xTaskGetTickCount();
+        libera(agora);
+        for (uint8_t b = 0; b < n_barramentos; b++) {
+            executa_barramento(b, agora);
+        }
+
+        TickType_t espera = proxima(xTaskGetTickCount());
+        if (espera != 0) {
+            ulTaskNotifyTake(pdTRUE, espera);
+            stats.despertares++;
+        }
+    }
+}
+
+bool sensor_sched_start(const sensor_desc_t *t, size_t n, const SemaphoreHandle_t *mutexes, size_t n_mutexes,
+                        UBaseType_t prioridade) {
+    if (n > SENSOR_SCHED_MAX || n_mutexes > SENSOR_SCHED_BARRAMENTOS) {
+        return false;
+    }
+
+    tabela = t;
+    n_sensores = n;
+    n_barramentos = n_mutexes;
+    memcpy(barramentos, mutexes, n_mutexes * sizeof(mutexes[0]));
+
+    for (size_t i = 0; i < n; i++) {
+        estado_t *st = &estados[i];
+        uint32_t prazo_ms = t[i].prazo_ms != 0 ? t[i].prazo_ms : t[i].periodo_ms;
+        uint32_t periodo_ms = t[i].periodo_ms != 0 ? t[i].periodo_ms : prazo_ms;
+
+        if (t[i].barramento >= n_mutexes || t[i].decode == NULL || prazo_ms == 0 ||
+            (t[i].start == NULL && t[i].fetch == NULL)) {
+            return false;
+        }
+        memset(st, 0, sizeof(*st));
+        st->periodo = ms_para_ticks(periodo_ms);
+        st->prazo = ms_para_ticks(prazo_ms);
+        periodic_init(&st->per, t[i].nome, periodo_ms, prazo_ms);
+    }
+
+    return task_affinity_create(sensor_sched_task, "sensores", PILHA_SENSORES, NULL, prioridade, AFINIDADE_SENSORES,
+                                NULL) == pdPASS;
+}
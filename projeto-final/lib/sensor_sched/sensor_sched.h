@@ -0,0 +1,81 @@
+#ifndef SENSOR_SCHED_H
+#define SENSOR_SCHED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+// Leitura de sensores por uma única task, a partir de uma tabela.
+//
+// Cada sensor declara período, prazo, barramento e as funções de um ciclo
+// de leitura: start inicia a conversão, fetch busca o resultado (quantas
+// vezes pedir) e decode converte e publica. start e fetch rodam com o
+// mutex do barramento tomado e respondem SENSOR_AGUARDA com o tempo até o
+// próximo passo, em vez de bloquear; nesse intervalo o executor atende os
+// outros sensores. decode roda sem o mutex.
+//
+// Os passos vencidos são executados por prazo absoluto (EDF: liberação +
+// prazo), e os de um mesmo barramento na mesma tomada do mutex. Entre eles
+// a task dorme até o próximo passo ou liberação; uma notificação da task
+// (ex.: de uma interrupção registrada no init do sensor, que roda nela)
+// acorda o executor para consultar os eventos dos sensores.
+//
+// Jitter, tempo de leitura e prazos de cada sensor ficam em lib/periodic,
+// com o nome do sensor.
+
+#define SENSOR_SCHED_MAX 8
+#define SENSOR_SCHED_BARRAMENTOS 2
+
+// Tempo máximo esperando o mutex de um barramento; esgotado, os passos
+// ficam para a próxima volta
+#define SENSOR_SCHED_ESPERA_MS 100
+
+typedef enum {
+    SENSOR_PRONTO,      // leitura completa: chama decode
+    SENSOR_AGUARDA,     // chamar fetch depois de *espera_ms (0: em seguida)
+    SENSOR_ERRO,        // leitura descartada
+} sensor_passo_t;
+
+typedef struct {
+    const char *nome;
+    uint32_t periodo_ms;    // 0: só por evento
+    uint32_t prazo_ms;      // a partir da liberação; 0 usa o período
+    uint8_t barramento;     // índice do mutex passado a sensor_sched_start
+
+    // Na task do executor, com o mutex do barramento (opcional)
+    bool (*init)(void *ctx);
+    // Início da leitura (opcional: sem ele o ciclo começa no fetch)
+    sensor_passo_t (*start)(void *ctx, uint32_t *espera_ms);
+    // Busca do resultado (obrigatório se start pedir espera)
+    sensor_passo_t (*fetch)(void *ctx, uint32_t *espera_ms);
+    // Conversão e publicação, fora do mutex
+    void (*decode)(void *ctx);
+    // Liberação antecipada: consultada a cada despertar com o sensor ocioso
+    bool (*evento)(void *ctx);
+
+    void *ctx;
+} sensor_desc_t;
+
+typedef struct {
+    uint32_t despertares;
+    uint32_t lotes;         // tomadas do mutex de um barramento
+    uint32_t passos;        // chamadas de start e fetch
+    uint32_t erros;         // leituras descartadas (SENSOR_ERRO)
+} sensor_sched_stats_t;
+
+// Cria a task "sensores" com a tabela (que deve continuar válida) e um
+// mutex por barramento (NULL: barramento sem mutex)
+bool sensor_sched_start(const sensor_desc_t *tabela, size_t n, const SemaphoreHandle_t *barramentos,
+                        size_t n_barramentos, UBaseType_t prioridade);
+
+// Troca o período de um sensor (índice na tabela) a partir da próxima
+// liberação; o prazo acompanha se era igual ao período. Para os callbacks.
+void sensor_sched_set_period(size_t id, uint32_t periodo_ms);
+
+void sensor_sched_get_stats(sensor_sched_stats_t *stats);
+
+#endif
@@ -32,6 +32,13 @@ SOFTWARE.
 
 #include "ssd1306.h"
 #include "font.h"
+#include "i2c_bus.h"
+
+#define SSD1306_WINDOW_CHUNK 64
+
+// framebuffers live here instead of the heap, so display ram is known at link time
+static uint8_t ssd1306_pool[SSD1306_POOL_BUFFERS][SSD1306_POOL_BUFSIZE+1];
+static bool ssd1306_pool_used[SSD1306_POOL_BUFFERS];
 
 inline static void swap(int32_t *a, int32_t *b) {
     int32_t *t=a;
@@ -40,7 +47,7 @@ inline static void swap(int32_t *a, int32_t *b) {
 }
 
 inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
-    switch(i2c_write_blocking(i2c, addr, src, len, false)) {
+    switch(i2c_bus_write(i2c, addr, src, len, false)) {
     case PICO_ERROR_GENERIC:
         printf("[%s] addr not acknowledged!\n", name);
         break;
@@ -58,6 +65,63 @@ inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
     fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
 }
 
+inline void ssd1306_cmd_list_init(ssd1306_cmd_list_t *l) {
+    l->buf[0]=0x00; // Co=0, D/C=0: every following byte is a command
+    l->len=0;
+}
+
+bool ssd1306_cmd_list_add(ssd1306_cmd_list_t *l, const uint8_t *cmds, size_t n) {
+    if(l->len+n>SSD1306_CMD_LIST_SIZE)
+        return false;
+
+    memcpy(l->buf+1+l->len, cmds, n);
+    l->len+=n;
+    return true;
+}
+
+inline void ssd1306_cmd_list_send(ssd1306_t *p, const ssd1306_cmd_list_t *l) {
+    if(l->len)
+        fancy_write(p->i2c_i, p->address, l->buf, l->len+1, "ssd1306_cmd_list_send");
+}
+
+// lists longer than SSD1306_CMD_LIST_SIZE go out in several transactions;
+// the controller keeps parsing parameters across them (the original driver
+// sent one byte per transaction)
+inline static void ssd1306_write_cmds(ssd1306_t *p, const uint8_t *cmds, size_t n) {
+    ssd1306_cmd_list_t l;
+
+    while(n) {
+        size_t chunk=n<SSD1306_CMD_LIST_SIZE?n:SSD1306_CMD_LIST_SIZE;
+
+        ssd1306_cmd_list_init(&l);
+        if(!ssd1306_cmd_list_add(&l, cmds, chunk))
+            return;
+        ssd1306_cmd_list_send(p, &l);
+        cmds+=chunk;
+        n-=chunk;
+    }
+}
+
+uint8_t *ssd1306_pool_alloc(size_t size) {
+    if(size>SSD1306_POOL_BUFSIZE)
+        return NULL;
+
+    for(size_t i=0; i<SSD1306_POOL_BUFFERS; ++i) {
+        if(!ssd1306_pool_used[i]) {
+            ssd1306_pool_used[i]=true;
+            return ssd1306_pool[i]+1;
+        }
+    }
+    return NULL;
+}
+
+void ssd1306_pool_free(uint8_t *buf) {
+    for(size_t i=0; i<SSD1306_POOL_BUFFERS; ++i) {
+        if(ssd1306_pool[i]+1==buf)
+            ssd1306_pool_used[i]=false;
+    }
+}
+
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
     p->width=width;
     p->height=height;
@@ -68,13 +132,11 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
 
     p->bufsize=(p->pages)*(p->width);
-    if((p->buffer=malloc(p->bufsize+1))==NULL) {
+    if((p->buffer=ssd1306_pool_alloc(p->bufsize))==NULL) {
         p->bufsize=0;
         return false;
     }
 
-    ++(p->buffer);
-
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
         SET_DISP,
@@ -109,14 +171,13 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
-    for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 
     return true;
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
-    free(p->buffer-1);
+    ssd1306_pool_free(p->buffer);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -128,8 +189,8 @@ inline void ssd1306_poweron(ssd1306_t *p) {
 }
 
 inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+    uint8_t cmds[]= {SET_CONTRAST, val};
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
 }
 
 inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
@@ -290,17 +351,127 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
-void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
+static inline void ssd1306_blit_byte(ssd1306_t *p, int32_t x, int32_t page, uint32_t shift, uint8_t b) {
+    if(!b || x<0 || x>=p->width)
+        return;
+
+    if(page>=0 && page<p->pages)
+        p->buffer[x+p->width*page]|=b<<shift;
+
+    if(shift && page+1>=0 && page+1<p->pages)
+        p->buffer[x+p->width*(page+1)]|=b>>(8-shift);
+}
+
+void ssd1306_blit_image(ssd1306_t *p, const ssd1306_image_t *img, int32_t x, int32_t y) {
+    const uint32_t shift=(uint32_t)y&7;
+    const int32_t page0=(y-(int32_t)shift)/8;
+    const uint32_t img_pages=(img->height>>3)+((img->height&7)>0);
+
+    if(!img->rle && !shift) {
+        // page aligned: whole bytes are or'ed in, clipped per page
+        const int32_t x_start=x<0?-x:0;
+        const int32_t x_end=x+img->width>p->width?p->width-x:img->width;
+
+        for(uint32_t pg=0; pg<img_pages; ++pg) {
+            const int32_t dp=page0+(int32_t)pg;
+            if(dp<0 || dp>=p->pages)
+                continue;
+
+            const uint8_t *src=img->data+pg*img->width;
+            uint8_t *dst=p->buffer+p->width*dp+x;
+            for(int32_t i=x_start; i<x_end; ++i)
+                dst[i]|=src[i];
+        }
+        return;
+    }
+
+    uint32_t col=0, pg=0;
+
+    if(!img->rle) {
+        for(uint32_t i=0; i<img_pages*img->width; ++i) {
+            ssd1306_blit_byte(p, x+(int32_t)col, page0+(int32_t)pg, shift, img->data[i]);
+            if(++col==img->width) {
+                col=0;
+                ++pg;
+            }
+        }
+        return;
+    }
+
+    // rle: 1xxxxxxx v -> (x+1) copies of v, 0xxxxxxx ... -> (x+1) literal bytes
+    for(uint32_t i=0; i<img->size && pg<img_pages;) {
+        const uint8_t c=img->data[i++];
+        const uint32_t run=(c&0x7F)+1;
+        const bool repeat=c&0x80;
+
+        for(uint32_t k=0; k<run && pg<img_pages; ++k) {
+            const uint32_t src=repeat?i:i+k;
+            if(src>=img->size)
+                return;
+
+            ssd1306_blit_byte(p, x+(int32_t)col, page0+(int32_t)pg, shift, img->data[src]);
+            if(++col==img->width) {
+                col=0;
+                ++pg;
+            }
+        }
+        i+=repeat?1:run;
+    }
+}
+
+void ssd1306_set_window(ssd1306_t *p, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+    uint8_t cmds[]= {SET_COL_ADDR, col_start, col_end, SET_PAGE_ADDR, page_start, page_end};
     if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+        cmds[1]+=32;
+        cmds[2]+=32;
     }
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    ssd1306_write_cmds(p, cmds, sizeof(cmds));
+}
+
+void ssd1306_show(ssd1306_t *p) {
+    ssd1306_show_frame(p, p->buffer);
+}
+
+void ssd1306_show_frame(ssd1306_t *p, uint8_t *frame) {
+    ssd1306_set_window(p, 0, p->width-1, 0, p->pages-1);
+
+    *(frame-1)=0x40;
 
-    *(p->buffer-1)=0x40;
+    fancy_write(p->i2c_i, p->address, frame-1, p->bufsize+1, "ssd1306_show");
+}
+
+void ssd1306_show_window(ssd1306_t *p, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+    if(col_end>=p->width)
+        col_end=p->width-1;
+    if(page_end>=p->pages)
+        page_end=p->pages-1;
+    if(col_start>col_end || page_start>page_end)
+        return;
+
+    ssd1306_set_window(p, col_start, col_end, page_start, page_end);
+
+    // rows of the window are not contiguous in buffer, gather them behind a data control byte
+    uint8_t chunk[1+SSD1306_WINDOW_CHUNK];
+    size_t n=0;
+    const size_t cols=col_end-col_start+1;
+
+    chunk[0]=0x40;
+    for(uint8_t pg=page_start; pg<=page_end; ++pg) {
+        const uint8_t *src=p->buffer+p->width*pg+col_start;
+        for(size_t left=cols; left;) {
+            size_t len=left<SSD1306_WINDOW_CHUNK-n?left:SSD1306_WINDOW_CHUNK-n;
+            memcpy(chunk+1+n, src, len);
+            n+=len;
+            src+=len;
+            left-=len;
+            if(n==SSD1306_WINDOW_CHUNK) {
+                fancy_write(p->i2c_i, p->address, chunk, n+1, "ssd1306_show_window");
+                n=0;
+            }
+        }
+    }
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+    if(n)
+        fancy_write(p->i2c_i, p->address, chunk, n+1, "ssd1306_show_window");
 }
@@ -33,6 +33,23 @@ SOFTWARE.
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
 
+/**
+*	@brief number of framebuffers in the static pool (override with -D)
+*
+*	each ssd1306_init takes one, the display manager takes one more per panel
+*	(builds using it need 2 * DISPLAY_MANAGER_MAX_PANELS, defined for the whole target)
+*/
+#ifndef SSD1306_POOL_BUFFERS
+#define SSD1306_POOL_BUFFERS 1
+#endif
+
+/**
+*	@brief size of each pooled framebuffer, largest panel is 128x64
+*/
+#ifndef SSD1306_POOL_BUFSIZE
+#define SSD1306_POOL_BUFSIZE (128*64/8)
+#endif
+
 /**
 *	@brief defines commands used in ssd1306
 */
@@ -70,6 +87,33 @@ typedef struct {
     size_t bufsize;		/**< buffer size */
 } ssd1306_t;
 
+/**
+*	@brief max number of command bytes in one command list
+*/
+#define SSD1306_CMD_LIST_SIZE 32
+
+/**
+*	@brief command list, sent to the display in a single i2c transaction
+*/
+typedef struct {
+    uint8_t buf[SSD1306_CMD_LIST_SIZE+1];	/**< control byte followed by commands */
+    uint8_t len;							/**< number of commands in list */
+} ssd1306_cmd_list_t;
+
+/**
+*	@brief image already laid out in ssd1306 page format
+*
+*	byte x of page n holds the column x of rows 8n..8n+7 (LSB on top).
+*	generated at build time by tools/assets/ssd1306_img2c.py
+*/
+typedef struct {
+    uint16_t width;			/**< width of image in pixels */
+    uint16_t height;		/**< height of image in pixels */
+    bool rle;				/**< whether data is run-length encoded */
+    uint32_t size;			/**< size of data in bytes */
+    const uint8_t *data;	/**< page data (raw or rle) */
+} ssd1306_image_t;
+
 /**
 *	@brief initialize display
 *
@@ -85,6 +129,25 @@ typedef struct {
 */
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance);
 
+/**
+*	@brief take a framebuffer from the static pool
+*
+*	the byte before the returned pointer is reserved for the i2c control byte.
+*	not thread safe, meant to be called during initialization
+*
+*	@param[in] size : size in bytes, up to SSD1306_POOL_BUFSIZE
+*
+*	@return pointer to buffer, NULL if pool is exhausted
+*/
+uint8_t *ssd1306_pool_alloc(size_t size);
+
+/**
+*	@brief return framebuffer to the static pool
+*
+*	@param[in] buf : pointer returned by ssd1306_pool_alloc
+*/
+void ssd1306_pool_free(uint8_t *buf);
+
 /**
 *	@brief deinitialize display
 *
@@ -127,6 +190,48 @@ void ssd1306_contrast(ssd1306_t *p, uint8_t val);
 */
 void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 
+/**
+	@brief start an empty command list
+
+	@param[out] l : command list
+
+*/
+void ssd1306_cmd_list_init(ssd1306_cmd_list_t *l);
+
+/**
+	@brief append command (or command argument) bytes to list
+
+	@param[in] l : command list
+	@param[in] cmds : command bytes
+	@param[in] n : number of bytes
+
+	@return bool.
+	@retval true for Success
+	@retval false if list is full, nothing is appended
+*/
+bool ssd1306_cmd_list_add(ssd1306_cmd_list_t *l, const uint8_t *cmds, size_t n);
+
+/**
+	@brief send all commands of list in one transaction
+
+	@param[in] p : instance of display
+	@param[in] l : command list
+
+*/
+void ssd1306_cmd_list_send(ssd1306_t *p, const ssd1306_cmd_list_t *l);
+
+/**
+	@brief set column and page window used by next data write
+
+	@param[in] p : instance of display
+	@param[in] col_start : first column
+	@param[in] col_end : last column
+	@param[in] page_start : first page
+	@param[in] page_end : last page
+
+*/
+void ssd1306_set_window(ssd1306_t *p, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end);
+
 /**
 	@brief display buffer, should be called on change
 
@@ -135,6 +240,27 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief send only a window of the display buffer, for partial updates
+
+	@param[in] p : instance of display
+	@param[in] col_start : first column
+	@param[in] col_end : last column
+	@param[in] page_start : first page
+	@param[in] page_end : last page
+
+*/
+void ssd1306_show_window(ssd1306_t *p, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end);
+
+/**
+	@brief send a whole frame from a buffer other than the display buffer
+
+	@param[in] p : instance of display
+	@param[in] frame : bufsize bytes from the pool, frame[-1] is overwritten with control byte
+
+*/
+void ssd1306_show_frame(ssd1306_t *p, uint8_t *frame);
+
 /**
 	@brief clear display buffer
 
@@ -225,6 +351,16 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
 */
 void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
 
+/**
+	@brief draw page format image, lit pixels are or'ed into buffer
+
+	@param[in] p : instance of display
+	@param[in] img : image generated by the asset pipeline
+	@param[in] x : x position of upper left corner
+	@param[in] y : y position of upper left corner
+*/
+void ssd1306_blit_image(ssd1306_t *p, const ssd1306_image_t *img, int32_t x, int32_t y);
+
 /**
 	@brief draw char with given font
 
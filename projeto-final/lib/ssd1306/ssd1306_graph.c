@@ -0,0 +1,85 @@
+#include <string.h>
+
+#include "ssd1306_graph.h"
+
+inline static void ssd1306_graph_clear_column(ssd1306_graph_t *g, uint8_t col) {
+    uint8_t *dst=g->disp->buffer+g->disp->width*g->page+g->x+col;
+
+    for(uint8_t pg=0; pg<g->pages; ++pg, dst+=g->disp->width)
+        *dst=0;
+}
+
+bool ssd1306_graph_init(ssd1306_graph_t *g, ssd1306_t *p, uint8_t x, uint8_t width, uint8_t page, uint8_t pages, int32_t min, int32_t max) {
+    if(width<2 || !pages || max<=min)
+        return false;
+
+    if((uint32_t)x+width>p->width || (uint32_t)page+pages>p->pages)
+        return false;
+
+    g->disp=p;
+    g->x=x;
+    g->width=width;
+    g->page=page;
+    g->pages=pages;
+    g->min=min;
+    g->max=max;
+    g->head=0;
+    g->last_row=0;
+    g->has_last=false;
+
+    for(uint8_t c=0; c<width; ++c)
+        ssd1306_graph_clear_column(g, c);
+
+    return true;
+}
+
+void ssd1306_graph_plot(ssd1306_graph_t *g, int32_t value) {
+    const uint32_t rows=(uint32_t)g->pages*8;
+
+    if(value<g->min)
+        value=g->min;
+    if(value>g->max)
+        value=g->max;
+
+    // row 0 is the top of the graph area
+    const uint8_t row=(uint8_t)(((int64_t)(g->max-value)*(rows-1))/((int64_t)g->max-g->min));
+
+    uint8_t top=row, bottom=row;
+    if(g->has_last) {
+        top=row<g->last_row?row:g->last_row;
+        bottom=row<g->last_row?g->last_row:row;
+    }
+
+    // vertical segment from previous sample, built one page byte at a time
+    uint8_t *dst=g->disp->buffer+g->disp->width*g->page+g->x+g->head;
+    for(uint8_t pg=0; pg<g->pages; ++pg, dst+=g->disp->width) {
+        const int32_t lo=top-pg*8, hi=bottom-pg*8;
+        if(hi<0 || lo>7) {
+            *dst=0;
+            continue;
+        }
+        const uint8_t from=lo<0?0:lo, to=hi>7?7:hi;
+        *dst=(uint8_t)((0xFF<<from)&(0xFF>>(7-to)));
+    }
+
+    g->last_row=row;
+    g->has_last=true;
+    g->head=g->head+1==g->width?0:g->head+1;
+
+    // blank cursor column marks where the sweep is
+    ssd1306_graph_clear_column(g, g->head);
+}
+
+void ssd1306_graph_push(ssd1306_graph_t *g, int32_t value) {
+    const uint8_t col=g->head;
+    const uint8_t page_end=g->page+g->pages-1;
+
+    ssd1306_graph_plot(g, value);
+
+    if(col+1<g->width) {
+        ssd1306_show_window(g->disp, g->x+col, g->x+col+1, g->page, page_end);
+    } else {
+        ssd1306_show_window(g->disp, g->x+col, g->x+col, g->page, page_end);
+        ssd1306_show_window(g->disp, g->x, g->x, g->page, page_end);
+    }
+}
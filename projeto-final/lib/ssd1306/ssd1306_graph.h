@@ -0,0 +1,66 @@
+/**
+* @file ssd1306_graph.h
+*
+* sweep sparkline graph for ssd1306 displays
+*
+* the graph owns a rectangle of whole pages on the display and works as a
+* circular window of columns: every sample redraws one column plus a blank
+* cursor column ahead of it, and only those columns are sent to the display.
+*/
+
+#ifndef _inc_ssd1306_graph
+#define _inc_ssd1306_graph
+
+#include "ssd1306.h"
+
+/**
+*	@brief state of one graph
+*/
+typedef struct {
+    ssd1306_t *disp;	/**< display the graph is drawn on */
+    uint8_t x;			/**< first column of graph area */
+    uint8_t width;		/**< number of columns (samples shown) */
+    uint8_t page;		/**< first page of graph area */
+    uint8_t pages;		/**< number of pages (height is pages*8) */
+    int32_t min;		/**< value drawn on bottom row */
+    int32_t max;		/**< value drawn on top row */
+    uint8_t head;		/**< column of next sample, relative to x */
+    uint8_t last_row;	/**< row of previous sample, to join samples */
+    bool has_last;		/**< whether last_row is valid */
+} ssd1306_graph_t;
+
+/**
+	@brief initialize graph and clear its area on buffer
+
+	@param[out] g : graph
+	@param[in] p : instance of display
+	@param[in] x : first column of graph area
+	@param[in] width : number of columns, at least 2
+	@param[in] page : first page of graph area
+	@param[in] pages : number of pages
+	@param[in] min : value on bottom row
+	@param[in] max : value on top row, greater than min
+
+	@return bool.
+	@retval true for Success
+	@retval false if area does not fit on display
+*/
+bool ssd1306_graph_init(ssd1306_graph_t *g, ssd1306_t *p, uint8_t x, uint8_t width, uint8_t page, uint8_t pages, int32_t min, int32_t max);
+
+/**
+	@brief plot a sample and send only the touched columns to display
+
+	@param[in] g : graph
+	@param[in] value : sample, clamped to [min, max]
+*/
+void ssd1306_graph_push(ssd1306_graph_t *g, int32_t value);
+
+/**
+	@brief plot a sample on buffer only (sent on next ssd1306_show)
+
+	@param[in] g : graph
+	@param[in] value : sample, clamped to [min, max]
+*/
+void ssd1306_graph_plot(ssd1306_graph_t *g, int32_t value);
+
+#endif
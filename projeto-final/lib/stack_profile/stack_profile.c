@@ -0,0 +1,26 @@
+#include "stack_profile.h"
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configRECORD_STACK_HIGH_ADDRESS != 1
+#error "stack_profile precisa de configRECORD_STACK_HIGH_ADDRESS = 1 (tamanho alocado)"
+#endif
+
+#define STACK_PROFILE_MAX_TASKS 20
+
+bool stack_profile_report(void) {
+    static TaskStatus_t status[STACK_PROFILE_MAX_TASKS];
+    UBaseType_t n = uxTaskGetSystemState(status, STACK_PROFILE_MAX_TASKS, NULL);
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        uint32_t alocado = (uint32_t)(status[i].pxEndOfStack - status[i].pxStackBase) + 1u;
+        uint32_t livre = (uint32_t)status[i].usStackHighWaterMark;
+
+        printf("[pilha] %s %lu %lu\n", status[i].pcTaskName, (unsigned long)(alocado - livre),
+               (unsigned long)alocado);
+    }
+    return n > 0;
+}
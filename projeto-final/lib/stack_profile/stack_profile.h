@@ -0,0 +1,16 @@
+#ifndef STACK_PROFILE_H
+#define STACK_PROFILE_H
+
+#include <stdbool.h>
+
+// Perfil de uso de pilha.
+//
+// stack_profile_report imprime uma linha "[pilha] <task> <usado> <alocado>"
+// (em palavras) por task, com o maior uso já registrado pelo kernel
+// (uxTaskGetStackHighWaterMark). A captura da serial alimenta
+// tools/stacks/stack_sizes.py, que gera task_stacks_gen.h.
+
+// Retorna false se houver mais tasks que o relatório comporta
+bool stack_profile_report(void);
+
+#endif
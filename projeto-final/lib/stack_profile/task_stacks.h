@@ -0,0 +1,73 @@
+#ifndef TASK_STACKS_H
+#define TASK_STACKS_H
+
+// Pilha de cada task, em palavras (StackType_t, 4 bytes no RP2040).
+//
+// Os valores abaixo são folgados e servem para o modo de perfil
+// (STACK_PROFILE), que mede o uso real. Com um log de perfil em
+// STACK_PROFILE_LOG, o CMake gera task_stacks_gen.h (tools/stacks) com os
+// tamanhos medidos mais a margem, que substituem estes.
+//
+// O nome da constante vem do nome da task: PILHA_ + nome em maiúsculas;
+// instâncias numeradas (display_i2c0, display_i2c1) dividem uma constante.
+
+#ifndef STACK_PROFILE
+#define STACK_PROFILE 0
+#endif
+
+#if !STACK_PROFILE && __has_include("task_stacks_gen.h")
+#include "task_stacks_gen.h"
+#endif
+
+#ifndef PILHA_DISPLAY
+#define PILHA_DISPLAY 3072
+#endif
+
+#ifndef PILHA_MQTT
+#define PILHA_MQTT 4096
+#endif
+
+#ifndef PILHA_DLOG
+#define PILHA_DLOG 2048
+#endif
+
+#ifndef PILHA_DIAG
+#define PILHA_DIAG 1024
+#endif
+
+#ifndef PILHA_TRACE
+#define PILHA_TRACE 1024
+#endif
+
+#ifndef PILHA_PILHAS
+#define PILHA_PILHAS 1024
+#endif
+
+#ifndef PILHA_COMPARACAO
+#define PILHA_COMPARACAO 1024
+#endif
+
+// Tasks das bibliotecas
+#ifndef PILHA_MQTT_TASK
+#define PILHA_MQTT_TASK 4096
+#endif
+
+#ifndef PILHA_WIFIMANAGER
+#define PILHA_WIFIMANAGER 2048
+#endif
+
+#ifndef PILHA_DISPLAY_I2C
+#define PILHA_DISPLAY_I2C 1024
+#endif
+
+// Executor dos sensores (lib/sensor_sched): os decodes rodam nela
+#ifndef PILHA_SENSORES
+#define PILHA_SENSORES 2048
+#endif
+
+// Task de timers do kernel (configTIMER_TASK_STACK_DEPTH)
+#ifndef PILHA_TMR_SVC
+#define PILHA_TMR_SVC 1024
+#endif
+
+#endif
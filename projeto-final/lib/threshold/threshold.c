@@ -0,0 +1,49 @@
+#include "threshold.h"
+
+#include <stddef.h>
+
+void threshold_init(threshold_t *t, float limiar_ativa, float limiar_desativa,
+                    uint32_t permanencia_ativa_ms, uint32_t permanencia_desativa_ms,
+                    threshold_cb_t on_change, void *ctx)
+{
+    t->limiar_ativa = limiar_ativa;
+    t->limiar_desativa = limiar_desativa;
+    t->permanencia_ativa_ms = permanencia_ativa_ms;
+    t->permanencia_desativa_ms = permanencia_desativa_ms;
+    t->on_change = on_change;
+    t->ctx = ctx;
+    t->ativo = false;
+    t->pendente = false;
+    t->desde_ms = 0;
+    t->transicoes = 0;
+}
+
+bool threshold_update(threshold_t *t, float valor, uint32_t agora_ms)
+{
+    // Além do limiar que leva ao estado oposto?
+    bool alem = t->ativo ? (valor < t->limiar_desativa) : (valor > t->limiar_ativa);
+
+    if (!alem) {
+        // Voltou para dentro da faixa: a contagem de permanência recomeça
+        t->pendente = false;
+        return false;
+    }
+
+    if (!t->pendente) {
+        t->pendente = true;
+        t->desde_ms = agora_ms;
+    }
+
+    uint32_t permanencia = t->ativo ? t->permanencia_desativa_ms : t->permanencia_ativa_ms;
+    if ((uint32_t)(agora_ms - t->desde_ms) < permanencia) {
+        return false;
+    }
+
+    t->ativo = !t->ativo;
+    t->pendente = false;
+    t->transicoes++;
+    if (t->on_change != NULL) {
+        t->on_change(t->ativo, valor, agora_ms, t->ctx);
+    }
+    return true;
+}
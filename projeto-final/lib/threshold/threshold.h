@@ -0,0 +1,41 @@
+#ifndef THRESHOLD_H
+#define THRESHOLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Evento de limiar com histerese e tempo mínimo de permanência.
+//
+// O estado só passa a ativo com o valor acima de limiar_ativa por pelo menos
+// permanencia_ativa_ms, e só volta a inativo abaixo de limiar_desativa por
+// permanencia_desativa_ms. Oscilações em torno de um limiar não geram
+// transições. Cada transição confirmada chama on_change uma vez.
+
+typedef void (*threshold_cb_t)(bool ativo, float valor, uint32_t agora_ms, void *ctx);
+
+typedef struct {
+    float limiar_ativa;
+    float limiar_desativa;            // menor que limiar_ativa
+    uint32_t permanencia_ativa_ms;
+    uint32_t permanencia_desativa_ms;
+    threshold_cb_t on_change;
+    void *ctx;
+
+    bool ativo;
+    bool pendente;                    // valor além do limiar, aguardando a permanência
+    uint32_t desde_ms;
+    uint32_t transicoes;
+} threshold_t;
+
+void threshold_init(threshold_t *t, float limiar_ativa, float limiar_desativa,
+                    uint32_t permanencia_ativa_ms, uint32_t permanencia_desativa_ms,
+                    threshold_cb_t on_change, void *ctx);
+
+// Processa uma amostra; retorna true se ela confirmou uma transição
+bool threshold_update(threshold_t *t, float valor, uint32_t agora_ms);
+
+static inline bool threshold_is_active(const threshold_t *t) {
+    return t->ativo;
+}
+
+#endif
@@ -0,0 +1,167 @@
+#include "trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/platform.h"
+#include "hardware/sync.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+_Static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE precisa ser potencia de 2");
+_Static_assert(sizeof(trace_event_t) == 8, "evento do trace deve ter 8 bytes");
+
+// Valores de ucQueueType no queue.c
+#define TRACE_FILA_MUTEX 1
+#define TRACE_FILA_SEMAFORO_CONTADOR 2
+#define TRACE_FILA_SEMAFORO_BINARIO 3
+#define TRACE_FILA_MUTEX_RECURSIVO 4
+
+typedef struct {
+    uint8_t tipo;       // trace_obj_t
+    char nome[TRACE_NOME_MAX];
+} trace_objeto_t;
+
+// Um anel por núcleo, escrito só pelo próprio núcleo com as interrupções
+// desligadas; head conta todos os eventos já gravados
+typedef struct {
+    trace_event_t ev[TRACE_RING_SIZE];
+    uint32_t head;
+} trace_ring_t;
+
+static trace_ring_t rings[TRACE_CORES];
+static trace_objeto_t objetos[TRACE_MAX_OBJETOS] = {
+    [TRACE_ID_TICK] = { TRACE_OBJ_ISR, "tick" },
+};
+static uint16_t n_objetos = TRACE_ID_TICK + 1;
+static volatile bool ativo = false;
+
+static const char letra_tipo[] = { 't', 'q', 'm', 's', 'i' };
+
+uint16_t trace_registra(trace_obj_t tipo, const char *nome) {
+    uint16_t id = 0;
+
+    // Seção crítica do kernel (trava entre os núcleos): traceQUEUE_CREATE
+    // roda fora de uma, e duas criações simultâneas pegariam o mesmo id.
+    // Aninha sem problema na de traceTASK_CREATE.
+    taskENTER_CRITICAL();
+    if (n_objetos < TRACE_MAX_OBJETOS) {
+        id = n_objetos++;
+        objetos[id].tipo = (uint8_t)tipo;
+        objetos[id].nome[0] = '\0';
+    }
+    taskEXIT_CRITICAL();
+
+    trace_nomeia(id, nome);
+    return id;
+}
+
+void trace_nomeia(uint16_t id, const char *nome) {
+    if (id == 0 || id >= TRACE_MAX_OBJETOS || nome == NULL) {
+        return;
+    }
+
+    size_t i = 0;
+    for (; i < TRACE_NOME_MAX - 1 && nome[i] != '\0'; i++) {
+        // Nome vai até o fim da linha no dump
+        objetos[id].nome[i] = (nome[i] == '\n' || nome[i] == '\r') ? ' ' : nome[i];
+    }
+    objetos[id].nome[i] = '\0';
+}
+
+uint16_t trace_registra_fila(uint8_t tipo_fila) {
+    switch (tipo_fila) {
+    case TRACE_FILA_MUTEX:
+    case TRACE_FILA_MUTEX_RECURSIVO:
+        return trace_registra(TRACE_OBJ_MUTEX, NULL);
+    case TRACE_FILA_SEMAFORO_CONTADOR:
+    case TRACE_FILA_SEMAFORO_BINARIO:
+        return trace_registra(TRACE_OBJ_SEMAFORO, NULL);
+    default:
+        return trace_registra(TRACE_OBJ_FILA, NULL);
+    }
+}
+
+void trace_evento(uint8_t tipo, uint16_t id) {
+    if (!ativo) {
+        return;
+    }
+
+    // Núcleo lido já com as interrupções desligadas: antes disso a task
+    // pode migrar e gravaria no anel do outro núcleo
+    uint32_t irq = save_and_disable_interrupts();
+    uint core = get_core_num();
+    trace_ring_t *r = &rings[core];
+
+    trace_event_t *e = &r->ev[r->head & (TRACE_RING_SIZE - 1)];
+    e->t_us = time_us_32();
+    e->tipo = tipo;
+    e->core = (uint8_t)core;
+    e->id = id;
+    r->head++;
+
+    restore_interrupts(irq);
+}
+
+void trace_start(void) {
+    for (uint core = 0; core < TRACE_CORES; core++) {
+        rings[core].head = 0;
+    }
+    __dmb();
+    ativo = true;
+}
+
+void trace_stop(void) {
+    ativo = false;
+    __dmb();
+}
+
+bool trace_ativo(void) {
+    return ativo;
+}
+
+void trace_dump(void) {
+    trace_stats_t stats;
+    trace_get_stats(&stats);
+
+    // O instante do dump permite ao conversor desfazer a volta do contador
+    // de 32 bits
+    printf("[trace] inicio %lu %lu %u %08lx\n", (unsigned long)(stats.gravados - stats.sobrescritos),
+           (unsigned long)stats.sobrescritos, (unsigned)stats.objetos, (unsigned long)time_us_32());
+
+    for (uint16_t id = 1; id < stats.objetos; id++) {
+        printf("[trace] o %u %c %s\n", (unsigned)id, letra_tipo[objetos[id].tipo], objetos[id].nome);
+    }
+
+    // 8 eventos por linha, cada um como tttttttt tt cc iiii em hexadecimal
+    for (uint core = 0; core < TRACE_CORES; core++) {
+        const trace_ring_t *r = &rings[core];
+        uint32_t n = r->head < TRACE_RING_SIZE ? r->head : TRACE_RING_SIZE;
+        uint32_t i = r->head - n;
+
+        while (i != r->head) {
+            printf("[trace] e ");
+            for (int k = 0; k < 8 && i != r->head; k++, i++) {
+                const trace_event_t *e = &r->ev[i & (TRACE_RING_SIZE - 1)];
+                printf("%08lx%02x%02x%04x", (unsigned long)e->t_us, (unsigned)e->tipo,
+                       (unsigned)e->core, (unsigned)e->id);
+            }
+            printf("\n");
+        }
+    }
+    printf("[trace] fim\n");
+}
+
+void trace_get_stats(trace_stats_t *stats) {
+    stats->gravados = 0;
+    stats->sobrescritos = 0;
+    for (uint core = 0; core < TRACE_CORES; core++) {
+        uint32_t head = rings[core].head;
+        stats->gravados += head;
+        if (head > TRACE_RING_SIZE) {
+            stats->sobrescritos += head - TRACE_RING_SIZE;
+        }
+    }
+    stats->objetos = n_objetos;
+}
@@ -0,0 +1,95 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Gravador de eventos do kernel.
+//
+// Os hooks trace* do FreeRTOS (trace_hooks.h, incluído pelo
+// FreeRTOSConfig.h quando TRACE_RECORDER = 1) gravam trocas de contexto,
+// operações em filas/mutexes/semáforos e entradas de ISR em um anel binário
+// por núcleo, com 8 bytes por evento. O anel sobrescreve os mais antigos:
+// trace_dump mostra sempre a janela mais recente.
+//
+// trace_dump envia o conteúdo como texto ("[trace] ..."), que pode ser
+// capturado junto com o resto da saída serial; tools/trace_export converte
+// para o formato JSON do Chrome/Perfetto (ui.perfetto.dev).
+
+// Eventos por núcleo (potência de 2)
+#define TRACE_RING_SIZE 512
+
+#define TRACE_CORES 2
+
+// Tasks, filas e ISRs com nome conhecido; o id 0 é "desconhecido"
+#define TRACE_MAX_OBJETOS 32
+#define TRACE_NOME_MAX 16
+
+// Id reservado para a ISR do tick do kernel
+#define TRACE_ID_TICK 1
+
+typedef enum {
+    TRACE_EV_TASK_IN = 1,           // id: task que passou a executar no núcleo
+    TRACE_EV_TASK_OUT,              // id: task que deixou o núcleo
+    TRACE_EV_TASK_PRONTA,           // id: task que entrou na lista de prontas
+    TRACE_EV_ISR_ENTER,             // id: ISR
+    TRACE_EV_ISR_EXIT,
+    TRACE_EV_FILA_ENVIO,            // id: fila; em um mutex é o give
+    TRACE_EV_FILA_ENVIO_FALHA,
+    TRACE_EV_FILA_BLOQUEIO_ENVIO,
+    TRACE_EV_FILA_RECEBE,           // em um mutex é o take
+    TRACE_EV_FILA_RECEBE_FALHA,     // timeout
+    TRACE_EV_FILA_BLOQUEIO_RECEBE,  // em um mutex: disputa
+    TRACE_EV_FILA_ENVIO_ISR,
+    TRACE_EV_FILA_RECEBE_ISR,
+} trace_evento_t;
+
+typedef enum {
+    TRACE_OBJ_TASK = 0,
+    TRACE_OBJ_FILA,
+    TRACE_OBJ_MUTEX,
+    TRACE_OBJ_SEMAFORO,
+    TRACE_OBJ_ISR,
+} trace_obj_t;
+
+typedef struct {
+    uint32_t t_us;
+    uint8_t tipo;       // trace_evento_t
+    uint8_t core;
+    uint16_t id;
+} trace_event_t;
+
+typedef struct {
+    uint32_t gravados;
+    uint32_t sobrescritos;  // perdidos por falta de espaço no anel
+    uint16_t objetos;
+} trace_stats_t;
+
+// Registra um objeto e retorna o id (0 se a tabela estiver cheia). O nome
+// é copiado e pode ser NULL (o conversor usa o tipo e o id).
+uint16_t trace_registra(trace_obj_t tipo, const char *nome);
+void trace_nomeia(uint16_t id, const char *nome);
+
+// Registro de filas criadas pelo kernel, a partir do ucQueueType
+uint16_t trace_registra_fila(uint8_t tipo_fila);
+
+void trace_evento(uint8_t tipo, uint16_t id);
+
+// A gravação começa parada; trace_dump exige a gravação parada
+void trace_start(void);
+void trace_stop(void);
+bool trace_ativo(void);
+void trace_dump(void);
+
+void trace_get_stats(trace_stats_t *stats);
+
+// ISRs da aplicação: registre com trace_registra(TRACE_OBJ_ISR, ...)
+static inline void trace_isr_enter(uint16_t id) {
+    trace_evento(TRACE_EV_ISR_ENTER, id);
+}
+
+static inline void trace_isr_exit(uint16_t id) {
+    trace_evento(TRACE_EV_ISR_EXIT, id);
+}
+
+#endif
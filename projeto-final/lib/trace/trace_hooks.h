@@ -0,0 +1,68 @@
+#ifndef TRACE_HOOKS_H
+#define TRACE_HOOKS_H
+
+// Hooks do FreeRTOS ligados ao gravador (lib/trace). Incluído no fim do
+// FreeRTOSConfig.h; as macros são expandidas dentro de tasks.c e queue.c,
+// onde os campos uxTaskNumber/uxQueueNumber (configUSE_TRACE_FACILITY)
+// guardam o id de cada objeto.
+
+#include "trace.h"
+
+#if configUSE_TRACE_FACILITY != 1
+#error "lib/trace precisa de configUSE_TRACE_FACILITY = 1"
+#endif
+
+// ISR do tick: 2 eventos por ms, ocupam boa parte do anel
+#ifndef TRACE_TICK_ISR
+#define TRACE_TICK_ISR 0
+#endif
+
+#define traceTASK_CREATE(pxNewTCB) \
+    (pxNewTCB)->uxTaskNumber = trace_registra(TRACE_OBJ_TASK, (pxNewTCB)->pcTaskName)
+
+// A troca de contexto também alimenta a contagem de tempo ocioso (lib/diag)
+#ifndef DIAG_TASK_SWITCHED_IN
+#define DIAG_TASK_SWITCHED_IN()
+#endif
+
+#define traceTASK_SWITCHED_IN() do { \
+        trace_evento(TRACE_EV_TASK_IN, (uint16_t)pxCurrentTCB->uxTaskNumber); \
+        DIAG_TASK_SWITCHED_IN(); \
+    } while (0)
+
+#define traceTASK_SWITCHED_OUT() \
+    trace_evento(TRACE_EV_TASK_OUT, (uint16_t)pxCurrentTCB->uxTaskNumber)
+
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    trace_evento(TRACE_EV_TASK_PRONTA, (uint16_t)(pxTCB)->uxTaskNumber)
+
+#define traceQUEUE_CREATE(pxNewQueue) \
+    (pxNewQueue)->uxQueueNumber = trace_registra_fila((pxNewQueue)->ucQueueType)
+
+#define traceQUEUE_REGISTRY_ADD(xQueue, pcQueueName) \
+    trace_nomeia((uint16_t)(xQueue)->uxQueueNumber, (pcQueueName))
+
+#define traceQUEUE_SEND(pxQueue) \
+    trace_evento(TRACE_EV_FILA_ENVIO, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+    trace_evento(TRACE_EV_FILA_ENVIO_FALHA, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    trace_evento(TRACE_EV_FILA_BLOQUEIO_ENVIO, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    trace_evento(TRACE_EV_FILA_RECEBE, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+    trace_evento(TRACE_EV_FILA_RECEBE_FALHA, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    trace_evento(TRACE_EV_FILA_BLOQUEIO_RECEBE, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    trace_evento(TRACE_EV_FILA_ENVIO_ISR, (uint16_t)(pxQueue)->uxQueueNumber)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    trace_evento(TRACE_EV_FILA_RECEBE_ISR, (uint16_t)(pxQueue)->uxQueueNumber)
+
+#if TRACE_TICK_ISR
+#define traceISR_ENTER() trace_evento(TRACE_EV_ISR_ENTER, TRACE_ID_TICK)
+#define traceISR_EXIT() trace_evento(TRACE_EV_ISR_EXIT, TRACE_ID_TICK)
+#define traceISR_EXIT_TO_SCHEDULER() trace_evento(TRACE_EV_ISR_EXIT, TRACE_ID_TICK)
+#endif
+
+#endif
@@ -4,6 +4,8 @@
 #include "task.h"
 #include "semphr.h"
 #include "wifi.h"
+#include "task_stacks.h"
+#include "task_affinity.h"
 
 #define WIFI_SSID      "Tolomelli TW"
 #define WIFI_PASSWORD  "JvGa@2728"
@@ -44,5 +46,5 @@ static void vTaskWiFiManager(void *pv) {
 
 void wifi_init(void) {
     xWiFiMutex = xSemaphoreCreateMutex();
-    xTaskCreate(vTaskWiFiManager, "WiFiManager", 2048, NULL, 1, NULL);
+    task_affinity_create(vTaskWiFiManager, "WiFiManager", PILHA_WIFIMANAGER, NULL, 1, AFINIDADE_WIFIMANAGER, NULL);
 }
\ No newline at end of file
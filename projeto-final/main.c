@@ -14,15 +14,79 @@
 
 // Imports externos
 #include "ssd1306.h"
+#include "ssd1306_graph.h"
 #include "wifi.h"
 #include "mqtt.h"
 #include "aht10.h"
 #include "bh1750.h"
+#include "i2c_bus.h"
 #include "mpu_wrapper.h"
-
-// Definição do limiar de luz para considerar a caixa aberta
-#define LIMIAR_LUX 10.0f
-#define LIMIAR_COLISAO 2.5f
+#include "colisao.h"
+#include "threshold.h"
+#include "dlog.h"
+#include "diag.h"
+#include "periodic.h"
+#include "sensor_sched.h"
+#include "task_stacks.h"
+#include "task_affinity.h"
+#if STACK_PROFILE
+#include "stack_profile.h"
+#endif
+#if TRACE_RECORDER
+#include "trace.h"
+#endif
+
+// Limiares de luz da caixa, com histerese: abre acima de 10 lux e só
+// fecha abaixo de 5 lux. A abertura é confirmada em duas conversões
+// seguidas; o fechamento pede meio segundo no escuro (sombra da mão)
+#define LIMIAR_LUX_ABERTA 10.0f
+#define LIMIAR_LUX_FECHADA 5.0f
+#define CAIXA_ABERTURA_MS 20
+#define CAIXA_FECHAMENTO_MS 500
+
+// Com a caixa fechada o BH1750 fica em conversões curtas (modo L, <= 24 ms)
+// para perceber a abertura; aberta, o ajuste automático fica livre
+#define BH1750_TEMPO_MAX_MS 24
+
+// Prazo de cada leitura do BH1750 a partir da liberação: o estado da caixa
+// tem de ser atualizado em meio segundo mesmo quando a conversão é curta
+#define BH1750_PRAZO_MS 500
+
+// AHT10: mediana de 3 conversões por leitura, uma leitura a cada 2 s
+#define AHT10_AMOSTRAS 3
+#define AHT10_PERIODO_MS 2000
+
+// Pino INT do MPU6050: acorda o executor dos sensores na detecção de
+// movimento (lib/colisao)
+#define MPU_INT_PIN 16
+
+// Gráfico de vibração no canto direito do display (amostra a cada 100 ms)
+#define GRAFICO_X 96
+#define GRAFICO_LARGURA 32
+#define GRAFICO_MAX_MG 4000
+#define DISPLAY_PERIODO_MS 100
+#define DISPLAY_TEXTO_A_CADA 10
+
+// Intervalo entre esvaziamentos do log adiado (lib/dlog)
+#define DLOG_PERIODO_MS 50
+
+// Diagnóstico de CPU, pilhas e heap publicado em pico/diag
+#define DIAG_PERIODO_MS 30000
+
+// Modo de perfil de pilha (STACK_PROFILE): publica mais vezes para
+// exercitar o caminho do MQTT e relata o uso das pilhas periodicamente
+#if STACK_PROFILE
+#define MQTT_PERIODO_MS 1000
+#else
+#define MQTT_PERIODO_MS 10000
+#endif
+#define PILHAS_PERIODO_MS 10000
+
+// Com o gravador de eventos ligado (TRACE_RECORDER), intervalo entre dumps
+#define TRACE_DUMP_MS 10000
+
+// Modo de comparação da afinidade (AFFINITY_COMPARE): duração de cada fase
+#define AFINIDADE_FASE_MS 60000
 
 // Estrutura global para dados dos sensores
 typedef struct
@@ -30,7 +94,9 @@ typedef struct
     float temperatura;
     float umidade;
     bool caixa_aberta;
+    float luminosidade;
     bool colisao;
+    float aceleracao;
 } sensor_data_t;
 
 volatile sensor_data_t sensor_data;
@@ -43,6 +109,7 @@ SemaphoreHandle_t xI2CMutex;
 #define I2C0_PORT i2c0
 #define I2C0_SDA_PIN 0
 #define I2C0_SCL_PIN 1
+#define I2C0_BAUDRATE COLISAO_I2C_BAUDRATE
 
 // Prototipos das funções I2C0
 int i2c_write(uint8_t addr, const uint8_t *data, uint16_t len);
@@ -57,9 +124,84 @@ void delay_ms(uint32_t ms);
 // Protótipos das tasks
 void display_task(void *pv);
 void mqtt_task(void *pv);
-void aht10_task(void *pv);
-void bh1750_task(void *pv);
-void mpu6050_task(void *pv);
+void dlog_task(void *pv);
+void diag_task(void *pv);
+#if TRACE_RECORDER
+void trace_task(void *pv);
+#endif
+#if STACK_PROFILE
+void pilhas_task(void *pv);
+#endif
+#if AFFINITY_COMPARE
+void comparacao_task(void *pv);
+#endif
+
+// Sensores do I2C0, lidos por uma única task (lib/sensor_sched)
+enum {
+    SENSOR_AHT10,
+    SENSOR_BH1750,
+    SENSOR_MPU6050,
+    N_SENSORES
+};
+
+typedef struct {
+    AHT10_Handle *sensor;
+    AHT10_Reading leitura;
+    uint32_t decorrido;
+} aht10_ctx_t;
+
+typedef struct {
+    bh1750_t *dev;
+    threshold_t caixa;
+    float lux;
+    bool reajustar;     // a caixa mudou de estado: novo limite de tempo
+} luz_ctx_t;
+
+static aht10_ctx_t aht10_ctx;
+static luz_ctx_t luz_ctx;
+static colisao_ctx_t colisao_ctx;
+
+static void caixa_evento(bool aberta, float lux, uint32_t agora_ms, void *ctx);
+static sensor_passo_t aht10_start(void *ctx, uint32_t *espera_ms);
+static sensor_passo_t aht10_fetch(void *ctx, uint32_t *espera_ms);
+static void aht10_decode(void *ctx);
+static sensor_passo_t luz_start(void *ctx, uint32_t *espera_ms);
+static sensor_passo_t luz_fetch(void *ctx, uint32_t *espera_ms);
+static void luz_decode(void *ctx);
+static void colisao_resultado(const colisao_ctx_t *c);
+
+// Período do BH1750 é o tempo de conversão do ajuste atual (começa no modo
+// L com o MTreg padrão); o decode o atualiza a cada leitura
+static const sensor_desc_t sensores[N_SENSORES] = {
+    [SENSOR_AHT10] = {
+        .nome = "AHT10",
+        .periodo_ms = AHT10_PERIODO_MS,
+        .start = aht10_start,
+        .fetch = aht10_fetch,
+        .decode = aht10_decode,
+        .ctx = &aht10_ctx,
+    },
+    [SENSOR_BH1750] = {
+        .nome = "BH1750",
+        .periodo_ms = BH1750_TEMPO_MAX_MS,
+        .prazo_ms = BH1750_PRAZO_MS,
+        .start = luz_start,
+        .fetch = luz_fetch,
+        .decode = luz_decode,
+        .ctx = &luz_ctx,
+    },
+    [SENSOR_MPU6050] = {
+        .nome = "MPU6050",
+        .periodo_ms = MPU_ESPERA_MS,
+        .prazo_ms = MPU_PRAZO_MS,
+        .init = colisao_init,
+        .start = colisao_start,
+        .fetch = colisao_fetch,
+        .decode = colisao_decode,
+        .evento = colisao_evento,
+        .ctx = &colisao_ctx,
+    },
+};
 
 int main()
 {
@@ -79,19 +221,9 @@ int main()
     // Inicia o MQTT
     mqtt_start();
 
-    // Configura I2C0
-    i2c_init(I2C0_PORT, 100000);
-    gpio_set_function(I2C0_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C0_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C0_SDA_PIN);
-    gpio_pull_up(I2C0_SCL_PIN);
-
-    // Configura I2C1
-    i2c_init(I2C1_PORT, 400000);
-    gpio_set_function(I2C1_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C1_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C1_SDA_PIN);
-    gpio_pull_up(I2C1_SCL_PIN);
+    // Configura I2C0 e I2C1 (os pinos ficam guardados para o bus clear)
+    i2c_bus_init(I2C0_PORT, I2C0_SDA_PIN, I2C0_SCL_PIN, I2C0_BAUDRATE);
+    i2c_bus_init(I2C1_PORT, I2C1_SDA_PIN, I2C1_SCL_PIN, 400000);
 
     // Processo de inicialização completo do OLED SSD1306
     ssd1306_t disp;
@@ -101,17 +233,24 @@ int main()
 
     // Inicializa BH1750
     printf("Inicializando BH1750...\n");
-    bh1750_init(I2C0_PORT);
+    static bh1750_t luz;
+    if (!bh1750_begin(&luz, I2C0_PORT, BH1750_MODO_L, BH1750_MTREG_PADRAO)) {
+        printf("BH1750 nao respondeu\n");
+    }
+    bh1750_set_auto(&luz, true, BH1750_TEMPO_MAX_MS);
     sleep_ms(1000);
 
     // Inicializa MPU6050
     printf("Inicializando MPU6050...\n");
-    mpu6050_init_c(I2C0_PORT, 0x68);
+    mpu6050_dev_t *mpu = mpu6050_open(I2C0_PORT, 0x68);
+    if (mpu == NULL) {
+        printf("MPU6050 nao respondeu\n");
+    }
     sleep_ms(1000);
 
     // Inicializa o sensor AHT10
     // Define estrutura do sensor
-    AHT10_Handle aht10 = {
+    static AHT10_Handle aht10 = {
         .iface = {
             .i2c_write = i2c_write,
             .i2c_read = i2c_read,
@@ -124,6 +263,7 @@ int main()
         while (1)
             sleep_ms(1000);
     }
+    AHT10_SetOversampling(&aht10, AHT10_AMOSTRAS);
 
     // Cria os Mutex
     xSensorMutex = xSemaphoreCreateMutex();
@@ -132,12 +272,38 @@ int main()
         printf("Erro ao criar Mutexes!\n");
     }
 
+    // Nomes para o depurador e para o trace
+    vQueueAddToRegistry(xSensorMutex, "dados");
+    vQueueAddToRegistry(xI2CMutex, "I2C");
+
     // Cria tasks
-    xTaskCreate(display_task, "display", 3072, &disp, 1, NULL);
-    xTaskCreate(mqtt_task, "mqtt", 4096, NULL, 2, NULL);
-    xTaskCreate(aht10_task, "AHT10", 2048, &aht10, 3, NULL);
-    xTaskCreate(bh1750_task, "BH1750", 2048, NULL, 3, NULL);
-    xTaskCreate(mpu6050_task, "MPU6050", 2048, NULL, 3, NULL);
+    // Pilhas em task_stacks.h (medidas com STACK_PROFILE) e núcleos em
+    // task_affinity.h (só com CORE_AFFINITY)
+    task_affinity_create(display_task, "display", PILHA_DISPLAY, &disp, 1, AFINIDADE_DISPLAY, NULL);
+    task_affinity_create(mqtt_task, "mqtt", PILHA_MQTT, NULL, 2, AFINIDADE_MQTT, NULL);
+    aht10_ctx.sensor = &aht10;
+    luz_ctx.dev = &luz;
+    threshold_init(&luz_ctx.caixa, LIMIAR_LUX_ABERTA, LIMIAR_LUX_FECHADA,
+                   CAIXA_ABERTURA_MS, CAIXA_FECHAMENTO_MS, caixa_evento, NULL);
+    colisao_ctx.dev = mpu;
+    colisao_ctx.pino_int = MPU_INT_PIN;
+    colisao_ctx.resultado = colisao_resultado;
+    if (!sensor_sched_start(sensores, N_SENSORES, &xI2CMutex, 1, 3)) {
+        printf("Erro ao iniciar os sensores!\n");
+    }
+    task_affinity_create(dlog_task, "dlog", PILHA_DLOG, NULL, tskIDLE_PRIORITY + 1, AFINIDADE_DLOG, NULL);
+    task_affinity_create(diag_task, "diag", PILHA_DIAG, NULL, tskIDLE_PRIORITY + 1, AFINIDADE_DIAG, NULL);
+#if TRACE_RECORDER
+    task_affinity_create(trace_task, "trace", PILHA_TRACE, NULL, tskIDLE_PRIORITY + 1, AFINIDADE_TRACE, NULL);
+    trace_start();
+#endif
+#if STACK_PROFILE
+    task_affinity_create(pilhas_task, "pilhas", PILHA_PILHAS, NULL, tskIDLE_PRIORITY + 1, AFINIDADE_PILHAS, NULL);
+#endif
+#if AFFINITY_COMPARE
+    task_affinity_create(comparacao_task, "comparacao", PILHA_COMPARACAO, NULL, tskIDLE_PRIORITY + 1,
+                         AFINIDADE_COMPARACAO, NULL);
+#endif
 
     // inicia FreeRTOS
     vTaskStartScheduler();
@@ -148,94 +314,135 @@ int main()
     };
 }
 
-void aht10_task(void *pv)
+// --- SENSORES ---
+// start e fetch rodam com o xI2CMutex já tomado pelo executor; entre os
+// passos o barramento fica livre para os outros sensores
+
+// AHT10: cada leitura é a mediana de AHT10_AMOSTRAS conversões; o fetch
+// consulta o busy até o fim de cada uma e já dispara a seguinte. Todo
+// SENSOR_ERRO descarta as amostras parciais com AHT10_Abort.
+static sensor_passo_t aht10_start(void *ctx, uint32_t *espera_ms)
 {
-    AHT10_Handle *sensor = (AHT10_Handle *)pv;
-    float temp_lida, hum_lida;
+    aht10_ctx_t *c = (aht10_ctx_t *)ctx;
 
-    while (true)
-    {
-        bool leitura_ok = false;
+    if (!AHT10_StartMeasurement(c->sensor)) {
+        AHT10_Abort(c->sensor);
+        return SENSOR_ERRO;
+    }
+    c->decorrido = AHT10_ConversionWaitMs(c->sensor);
+    *espera_ms = c->decorrido;
+    return SENSOR_AGUARDA;
+}
 
-        // --- PROTEÇÃO DO I2C ---
-        if (xSemaphoreTake(xI2CMutex, pdMS_TO_TICKS(200)) == pdTRUE) {
-            leitura_ok = AHT10_ReadTemperatureHumidity(sensor, &temp_lida, &hum_lida);
-            xSemaphoreGive(xI2CMutex);
-        }
+static sensor_passo_t aht10_fetch(void *ctx, uint32_t *espera_ms)
+{
+    aht10_ctx_t *c = (aht10_ctx_t *)ctx;
 
-        if (leitura_ok)
-        {
-            if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(100)) == pdTRUE)
-            {
-                sensor_data.temperatura = temp_lida;
-                sensor_data.umidade = hum_lida;
-                xSemaphoreGive(xSensorMutex);
-            }
+    switch (AHT10_Poll(c->sensor, &c->leitura, c->decorrido))
+    {
+    case AHT10_READY:
+        return SENSOR_PRONTO;
+    case AHT10_SAMPLE:
+        return aht10_start(ctx, espera_ms);
+    case AHT10_BUSY:
+        if (c->decorrido >= AHT10_TIMEOUT_MS) {
+            break;
         }
-        vTaskDelay(pdMS_TO_TICKS(2000)); 
+        *espera_ms = AHT10_POLL_MS;
+        c->decorrido += AHT10_POLL_MS;
+        return SENSOR_AGUARDA;
+    default:
+        break;
     }
+
+    AHT10_Abort(c->sensor);
+    return SENSOR_ERRO;
 }
 
-// --- TASK DO SENSOR DE LUMINOSIDADE ---
-void bh1750_task(void *pv)
+static void aht10_decode(void *ctx)
 {
-    float lux_lido = -1.0f; // Inicializa com erro
+    aht10_ctx_t *c = (aht10_ctx_t *)ctx;
 
-    while (true)
+    if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(100)) == pdTRUE)
     {
-        // --- PROTEÇÃO DO I2C ---
-        if (xSemaphoreTake(xI2CMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            lux_lido = bh1750_read_lux(I2C0_PORT);
-            xSemaphoreGive(xI2CMutex);
-        }
-        // -----------------------
+        sensor_data.temperatura = c->leitura.temperature_c100 / 100.0f;
+        sensor_data.umidade = c->leitura.humidity_c100 / 100.0f;
+        xSemaphoreGive(xSensorMutex);
+    }
+}
 
-        if (lux_lido >= 0)
-        {
-            if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(100)) == pdTRUE)
-            {
-                sensor_data.caixa_aberta = (lux_lido > LIMIAR_LUX);
-                xSemaphoreGive(xSensorMutex);
-            }
+// Transição confirmada da caixa: vai direto para a fila do MQTT, sem
+// esperar o próximo envio periódico
+static void caixa_evento(bool aberta, float lux, uint32_t agora_ms, void *ctx)
+{
+    (void)ctx;
+    char payload[96];
+
+    snprintf(payload, sizeof(payload), "{\"caixa\": \"%s\", \"luz\": %.1f, \"t_ms\": %lu}",
+             aberta ? "aberta" : "fechada", lux, (unsigned long)agora_ms);
+    mqtt_publish_async("pico/eventos", payload);
+}
+
+// BH1750: medição contínua, o fetch só lê a última conversão
+static sensor_passo_t luz_start(void *ctx, uint32_t *espera_ms)
+{
+    luz_ctx_t *c = (luz_ctx_t *)ctx;
+
+    // Na troca de estado muda o limite de tempo do sensor; ao fechar, volta
+    // direto às conversões curtas e espera a primeira delas
+    if (c->reajustar)
+    {
+        bool aberta = threshold_is_active(&c->caixa);
+
+        c->reajustar = false;
+        bh1750_set_auto(c->dev, true, aberta ? 0 : BH1750_TEMPO_MAX_MS);
+        if (!aberta && bh1750_configure(c->dev, BH1750_MODO_L, BH1750_MTREG_PADRAO)) {
+            *espera_ms = bh1750_tempo_ms(c->dev);
         }
-        vTaskDelay(pdMS_TO_TICKS(500));
     }
+    return SENSOR_AGUARDA;
 }
 
-// --- TASK MPU6050 (COLISÃO) ---
-void mpu6050_task(void *pv) {
-    float ax, ay, az;
-    float magnitude;
-    int contador_reset_colisao = 0;
-
-    while(true) {
-        // --- PROTEÇÃO DO I2C ---
-        if (xSemaphoreTake(xI2CMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            mpu6050_read_accel_c(&ax, &ay, &az);
-            xSemaphoreGive(xI2CMutex);
-        // -----------------------
-
-            magnitude = sqrtf((ax * ax) + (ay * ay) + (az * az));
-            bool impacto_detectado = (magnitude > LIMIAR_COLISAO);
-
-            if (impacto_detectado) {
-                printf("Impacto! Mag: %.2f\n", magnitude);
-                contador_reset_colisao = 100; 
-            }
-        }
+static sensor_passo_t luz_fetch(void *ctx, uint32_t *espera_ms)
+{
+    luz_ctx_t *c = (luz_ctx_t *)ctx;
+    (void)espera_ms;
 
-        // Atualiza struct global (Mutex de DADOS)
-        if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
-             // ... sua lógica de colisão original ...
-             if (contador_reset_colisao > 0) {
-                sensor_data.colisao = true;
-                contador_reset_colisao--;
-            } else {
-                sensor_data.colisao = false;
-            }
-            xSemaphoreGive(xSensorMutex);
-        }
-        vTaskDelay(pdMS_TO_TICKS(100)); 
+    return bh1750_read(c->dev, &c->lux, NULL) ? SENSOR_PRONTO : SENSOR_ERRO;
+}
+
+static void luz_decode(void *ctx)
+{
+    luz_ctx_t *c = (luz_ctx_t *)ctx;
+    uint32_t agora_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+    if (threshold_update(&c->caixa, c->lux, agora_ms)) {
+        c->reajustar = true;
+    }
+
+    if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(100)) == pdTRUE)
+    {
+        sensor_data.caixa_aberta = threshold_is_active(&c->caixa);
+        sensor_data.luminosidade = c->lux;
+        xSemaphoreGive(xSensorMutex);
+    }
+
+    // Uma conversão nova por leitura
+    sensor_sched_set_period(SENSOR_BH1750, bh1750_tempo_ms(c->dev));
+}
+
+// MPU6050 (colisão): os passos ficam em lib/colisao; aqui só a publicação
+static void colisao_resultado(const colisao_ctx_t *c)
+{
+    if (c->impacto) {
+        DLOG("Impacto! Mag: %.2f\n", c->magnitude);
+    }
+
+    // Atualiza struct global (Mutex de DADOS)
+    if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(50)) == pdTRUE) {
+        sensor_data.aceleracao = c->magnitude;
+        sensor_data.colisao = c->colisao;
+        xSemaphoreGive(xSensorMutex);
     }
 }
 
@@ -247,21 +454,42 @@ void display_task(void *pv)
     // Variáveis locais para armazenar cópia dos dados
     float temp_local = 0.0f;
     float hum_local = 0.0f;
-    const char *status_caixa;
-    const char *status_colisao;
+    float acel_local = 0.0f;
+    const char *status_caixa = "";
+    const char *status_colisao = "";
+
+    // O gráfico envia só as colunas novas; o texto é redesenhado a cada segundo
+    ssd1306_graph_t grafico;
+    ssd1306_clear(disp);
+    ssd1306_graph_init(&grafico, disp, GRAFICO_X, GRAFICO_LARGURA, 0, disp->pages, 0, GRAFICO_MAX_MG);
+    uint32_t ciclo = 0;
+    static periodic_t per;
+
+    periodic_init(&per, "display", DISPLAY_PERIODO_MS, 0);
 
     while (true)
     {
+        periodic_wait(&per);
+
         if (xSemaphoreTake(xSensorMutex, pdMS_TO_TICKS(100)) == pdTRUE)
         {
             temp_local = sensor_data.temperatura;
             hum_local = sensor_data.umidade;
+            acel_local = sensor_data.aceleracao;
             status_caixa = sensor_data.caixa_aberta ? "Aberta" : "Fechada";
             status_colisao = sensor_data.colisao ? "SIM" : "nao";
             xSemaphoreGive(xSensorMutex);
         }
 
-        ssd1306_clear(disp);
+        // Entre as atualizações de texto só a coluna nova do gráfico vai pelo I2C
+        if (ciclo++ % DISPLAY_TEXTO_A_CADA != 0)
+        {
+            ssd1306_graph_push(&grafico, (int32_t)(acel_local * 1000.0f));
+            continue;
+        }
+
+        ssd1306_graph_plot(&grafico, (int32_t)(acel_local * 1000.0f));
+        ssd1306_clear_square(disp, 0, 0, GRAFICO_X, disp->height);
 
         // Formata e exibe usando as variáveis locais
         sprintf(buffer, "Temp: %.1f C", temp_local);
@@ -277,15 +505,15 @@ void display_task(void *pv)
         ssd1306_draw_string(disp, 10, 55, 1, buffer);
 
         ssd1306_show(disp);
-        vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }
 
 void mqtt_task(void *pv)
 {
-    char payload[100];
+    char payload[128];
     float temp_local;
     float hum_local;
+    float luz_local;
     const char *status_caixa;
     const char *status_colisao;
 
@@ -299,13 +527,14 @@ void mqtt_task(void *pv)
                 // Copia os dados para variáveis locais para liberar o mutex rapidamente
                 temp_local = sensor_data.temperatura;
                 hum_local = sensor_data.umidade;
+                luz_local = sensor_data.luminosidade;
                 status_caixa = sensor_data.caixa_aberta ? "aberta" : "fechada";
                 status_colisao = sensor_data.colisao ? "SIM" : "nao";
 
                 xSemaphoreGive(xSensorMutex);
 
                 // Formata os dados em uma string JSON
-                sprintf(payload, "{\"temperatura\": %.1f, \"umidade\": %.1f, \"caixa\": \"%s\", \"colisao\": \"%s\"}", temp_local, hum_local, status_caixa, status_colisao);
+                sprintf(payload, "{\"temperatura\": %.1f, \"umidade\": %.1f, \"luz\": %.1f, \"caixa\": \"%s\", \"colisao\": \"%s\"}", temp_local, hum_local, luz_local, status_caixa, status_colisao);
 
                 // Publica os dados no tópico MQTT. Você pode alterar "pico/dados".
                 mqtt_publish_async("pico/dados", payload);
@@ -314,28 +543,151 @@ void mqtt_task(void *pv)
         else
         {
             // Tenta reconectar se não estiver conectado
-            printf("Tentando reconectar ao MQTT...\n");
+            DLOG("Tentando reconectar ao MQTT...\n");
+        }
+        vTaskDelay(pdMS_TO_TICKS(MQTT_PERIODO_MS)); // Publica a cada 10 segundos (1 s no perfil)
+    }
+}
+
+// --- TASK DO LOG ADIADO ---
+// Formata e envia pela stdio o que as outras tasks registraram com DLOG;
+// fica na prioridade mais baixa para que a USB nunca atrase as medições
+void dlog_task(void *pv)
+{
+    (void)pv;
+    uint32_t descartados = 0;
+    dlog_stats_t stats;
+
+    while (true)
+    {
+        dlog_flush();
+
+        dlog_get_stats(&stats);
+        if (stats.descartados != descartados) {
+            printf("[dlog] %lu registros descartados (anel cheio)\n",
+                   (unsigned long)(stats.descartados - descartados));
+            descartados = stats.descartados;
+        }
+        vTaskDelay(pdMS_TO_TICKS(DLOG_PERIODO_MS));
+    }
+}
+
+// --- TASK DE DIAGNÓSTICO ---
+// Uso de CPU por task e por núcleo na última janela, menor folga de pilha
+// de cada task e heap livre (atual e mínimo), em uma mensagem compacta.
+// Em pico/diag/periodos vão os contadores das tasks periódicas (lib/periodic)
+void diag_task(void *pv)
+{
+    (void)pv;
+    static diag_t diag;
+    char payload[256];
+
+    diag_init(&diag);
+
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(DIAG_PERIODO_MS));
+
+        if (!diag_update(&diag)) {
+            DLOG("[diag] mais de %d tasks\n", DIAG_MAX_TASKS);
+            continue;
+        }
+        if (mqtt_is_connected() && diag_format_json(&diag, payload, sizeof(payload)) > 0) {
+            mqtt_publish_async("pico/diag", payload);
+        }
+        if (mqtt_is_connected() && periodic_format_json(payload, sizeof(payload)) > 0) {
+            mqtt_publish_async("pico/diag/periodos", payload);
         }
-        vTaskDelay(pdMS_TO_TICKS(10000)); // Publica a cada 10 segundos
     }
 }
 
+#if TRACE_RECORDER
+// --- TASK DO TRACE ---
+// A cada TRACE_DUMP_MS envia a janela mais recente de eventos do kernel
+// (converter com tools/trace_export). A gravação fica parada durante o
+// envio, que leva alguns ms pela USB.
+void trace_task(void *pv)
+{
+    (void)pv;
+
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DUMP_MS));
+        trace_stop();
+        trace_dump();
+        trace_start();
+    }
+}
+#endif
+
+#if STACK_PROFILE
+// --- TASK DO PERFIL DE PILHA ---
+// Capture a serial enquanto a caixa é aberta, fechada e sacudida e passe o
+// log ao CMake (STACK_PROFILE_LOG) para gerar as pilhas medidas
+void pilhas_task(void *pv)
+{
+    (void)pv;
+
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(PILHAS_PERIODO_MS));
+        stack_profile_report();
+    }
+}
+#endif
+
+#if AFFINITY_COMPARE
+// --- COMPARAÇÃO DA AFINIDADE ---
+// Alterna o perfil de afinidade (tasks fixas) com tasks livres a cada
+// AFINIDADE_FASE_MS. No fim de cada fase envia o jitter e os prazos das
+// tasks periódicas medidos nela (mesmo formato de pico/diag/periodos)
+void comparacao_task(void *pv)
+{
+    (void)pv;
+    char payload[320];
+    bool fixas = true;
+
+    while (true)
+    {
+        task_affinity_apply(fixas);
+        periodic_reset_stats();
+        vTaskDelay(pdMS_TO_TICKS(AFINIDADE_FASE_MS));
+
+        int n = snprintf(payload, sizeof(payload), "{\"fase\":\"%s\",\"per\":", fixas ? "fixas" : "livres");
+        size_t m = periodic_format_json(payload + n, sizeof(payload) - (size_t)n - 1);
+        if (m > 0) {
+            payload[n + m] = '}';
+            payload[n + m + 1] = '\0';
+            printf("[afinidade] %s\n", payload);
+            if (mqtt_is_connected()) {
+                mqtt_publish_async("pico/diag/afinidade", payload);
+            }
+        }
+        fixas = !fixas;
+    }
+}
+#endif
+
 // Função para escrita I2C
 int i2c_write(uint8_t addr, const uint8_t *data, uint16_t len)
 {
-    int result = i2c_write_blocking(I2C0_PORT, addr, data, len, false);
+    int result = i2c_bus_write(I2C0_PORT, addr, data, len, false);
     return result < 0 ? -1 : 0;
 }
 
 // Função para leitura I2C
 int i2c_read(uint8_t addr, uint8_t *data, uint16_t len)
 {
-    int result = i2c_read_blocking(I2C0_PORT, addr, data, len, false);
+    int result = i2c_bus_read(I2C0_PORT, addr, data, len, false);
     return result < 0 ? -1 : 0;
 }
 
-// Função para delay
+// Função para delay (com o escalonador rodando, libera a CPU)
 void delay_ms(uint32_t ms)
 {
-    sleep_ms(ms);
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        vTaskDelay(pdMS_TO_TICKS(ms));
+    } else {
+        sleep_ms(ms);
+    }
 }
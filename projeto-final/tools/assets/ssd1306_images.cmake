@@ -0,0 +1,49 @@
+# Pipeline de imagens do SSD1306
+#
+#   ssd1306_add_images(<target> [RLE] [INVERT] [PREFIX <prefixo>] IMAGES <arquivo.bmp|png>...)
+#
+# Converte cada imagem em tempo de compilação para um ssd1306_image_t em
+# flash (img_<nome do arquivo>), já no formato de página do display.
+# Inclua o header gerado (#include "img_<nome>.h") e desenhe com
+# ssd1306_blit_image(). PREFIX troca o "img_" do nome, para converter a
+# mesma imagem com opções diferentes no mesmo target.
+
+set(SSD1306_IMG2C ${CMAKE_CURRENT_LIST_DIR}/ssd1306_img2c.py)
+
+function(ssd1306_add_images target)
+    cmake_parse_arguments(ARG "RLE;INVERT" "PREFIX" "IMAGES" ${ARGN})
+
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+    if(NOT DEFINED ARG_PREFIX)
+        set(ARG_PREFIX img_)
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/ssd1306_images)
+    set(flags "")
+    if(ARG_RLE)
+        list(APPEND flags --rle)
+    endif()
+    if(ARG_INVERT)
+        list(APPEND flags --invert)
+    endif()
+
+    foreach(image ${ARG_IMAGES})
+        get_filename_component(image_path ${image} ABSOLUTE)
+        get_filename_component(stem ${image} NAME_WE)
+        string(TOLOWER "${ARG_PREFIX}${stem}" name)
+        string(MAKE_C_IDENTIFIER ${name} name)
+
+        add_custom_command(
+                OUTPUT ${out_dir}/${name}.c ${out_dir}/${name}.h
+                COMMAND ${Python3_EXECUTABLE} ${SSD1306_IMG2C} ${image_path} -o ${out_dir} -n ${name} ${flags}
+                DEPENDS ${image_path} ${SSD1306_IMG2C}
+                COMMENT "Convertendo ${stem} para o formato do SSD1306"
+                VERBATIM
+                )
+
+        target_sources(${target} PRIVATE ${out_dir}/${name}.c ${out_dir}/${name}.h)
+    endforeach()
+
+    target_include_directories(${target} PRIVATE ${out_dir})
+endfunction()
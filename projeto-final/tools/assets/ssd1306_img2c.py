@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""Converte imagens BMP/PNG em bitmaps no formato de página do SSD1306.
+
+Gera <nome>.h e <nome>.c com um `const ssd1306_image_t <nome>` (em flash),
+pronto para `ssd1306_blit_image`. Cada byte x da página n contém a coluna x
+das linhas 8n..8n+7, bit menos significativo em cima.
+
+Por padrão pixels escuros e opacos ficam acesos, como em
+`ssd1306_bmp_show_image`; use --invert para o contrário.
+
+Com --rle os dados são comprimidos (estilo PackBits) quando isso reduz o
+tamanho:
+    1xxxxxxx v        -> (x+1) cópias de v
+    0xxxxxxx b0..bx   -> (x+1) bytes literais
+"""
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+def le(data, off, n):
+    return int.from_bytes(data[off:off + n], 'little')
+
+
+def load_bmp(data):
+    """Retorna (largura, altura, [[(luminância, alfa)]])."""
+    off_bits = le(data, 10, 4)
+    hdr_size = le(data, 14, 4)
+    width = le(data, 18, 4)
+    height = struct.unpack_from('<i', data, 22)[0]
+    bpp = le(data, 28, 2)
+    compression = le(data, 30, 4) if hdr_size >= 40 else 0
+
+    if compression not in (0, 3):
+        raise ValueError('BMP comprimido não suportado')
+    if bpp not in (1, 4, 8, 24, 32):
+        raise ValueError(f'BMP com {bpp} bits por pixel não suportado')
+
+    palette = []
+    if bpp <= 8:
+        count = le(data, 46, 4) if hdr_size >= 40 else 0
+        count = count or (1 << bpp)
+        table = 14 + hdr_size
+        for i in range(count):
+            b, g, r = data[table + 4 * i:table + 4 * i + 3]
+            palette.append((r, g, b))
+
+    bottom_up = height > 0
+    height = abs(height)
+    stride = ((width * bpp + 31) // 32) * 4
+
+    rows = []
+    for y in range(height):
+        src_y = height - 1 - y if bottom_up else y
+        line = data[off_bits + src_y * stride:off_bits + (src_y + 1) * stride]
+        row = []
+        for x in range(width):
+            if bpp <= 8:
+                bit = x * bpp
+                idx = (line[bit >> 3] >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1)
+                r, g, b = palette[idx]
+                a = 255
+            elif bpp == 24:
+                b, g, r = line[3 * x:3 * x + 3]
+                a = 255
+            else:
+                b, g, r, a = line[4 * x:4 * x + 4]
+            row.append(((r * 299 + g * 587 + b * 114) // 1000, a))
+        rows.append(row)
+
+    # BMP de 32 bits costuma vir com alfa zerado: nesse caso é tudo opaco
+    if bpp == 32 and not any(a for row in rows for _, a in row):
+        rows = [[(lum, 255) for lum, _ in row] for row in rows]
+
+    return width, height, rows
+
+
+def load_png(data):
+    """Retorna (largura, altura, [[(luminância, alfa)]])."""
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, kind = struct.unpack_from('>I4s', data, pos)
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            trns = body
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    if interlace:
+        raise ValueError('PNG entrelaçado não suportado')
+    if depth == 16:
+        raise ValueError('PNG de 16 bits não suportado')
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    bits_pp = channels * depth
+    bpp = max(1, bits_pp // 8)
+    stride = (width * bits_pp + 7) // 8
+    raw = zlib.decompress(idat)
+
+    # Desfaz os filtros de linha
+    lines = []
+    prev = bytearray(stride)
+    for y in range(height):
+        ftype = raw[y * (stride + 1)]
+        cur = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = cur[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                cur[i] = (cur[i] + a) & 0xFF
+            elif ftype == 2:
+                cur[i] = (cur[i] + b) & 0xFF
+            elif ftype == 3:
+                cur[i] = (cur[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                cur[i] = (cur[i] + pred) & 0xFF
+        lines.append(cur)
+        prev = cur
+
+    rows = []
+    for line in lines:
+        row = []
+        for x in range(width):
+            if depth < 8:
+                bit = x * depth
+                v = (line[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1)
+            else:
+                v = None
+
+            if ctype == 0:
+                if v is None:
+                    v = line[x]
+                else:
+                    v = v * 255 // ((1 << depth) - 1)
+                row.append((v, 255))
+            elif ctype == 3:
+                idx = v if v is not None else line[x]
+                r, g, b = palette[idx]
+                a = trns[idx] if idx < len(trns) else 255
+                row.append(((r * 299 + g * 587 + b * 114) // 1000, a))
+            elif ctype == 2:
+                r, g, b = line[3 * x:3 * x + 3]
+                row.append(((r * 299 + g * 587 + b * 114) // 1000, 255))
+            elif ctype == 4:
+                row.append((line[2 * x], line[2 * x + 1]))
+            else:
+                r, g, b, a = line[4 * x:4 * x + 4]
+                row.append(((r * 299 + g * 587 + b * 114) // 1000, a))
+        rows.append(row)
+
+    return width, height, rows
+
+
+def to_pages(width, height, rows, threshold, invert):
+    pages = (height + 7) // 8
+    out = bytearray(pages * width)
+    for y in range(height):
+        for x in range(width):
+            lum, alpha = rows[y][x]
+            lit = lum < threshold
+            if invert:
+                lit = not lit
+            if alpha >= 128 and lit:
+                out[(y >> 3) * width + x] |= 1 << (y & 7)
+    return bytes(out)
+
+
+def rle_encode(data):
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+
+    def flush():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            flush()
+            out.append(0x80 | (run - 1))
+            out.append(data[i])
+            i += run
+        else:
+            literal.extend(data[i:i + run])
+            i += run
+    flush()
+    return bytes(out)
+
+
+def write_sources(out_dir, name, width, height, data, rle):
+    guard = re.sub(r'\W', '_', name).upper() + '_H'
+    with open(os.path.join(out_dir, name + '.h'), 'w') as f:
+        f.write('// Gerado por ssd1306_img2c.py - não editar\n\n')
+        f.write(f'#ifndef {guard}\n#define {guard}\n\n')
+        f.write('#include "ssd1306.h"\n\n')
+        f.write(f'extern const ssd1306_image_t {name};\n\n')
+        f.write(f'#endif\n')
+
+    with open(os.path.join(out_dir, name + '.c'), 'w') as f:
+        f.write('// Gerado por ssd1306_img2c.py - não editar\n\n')
+        f.write(f'#include "{name}.h"\n\n')
+        f.write(f'static const uint8_t {name}_data[{len(data)}] = {{\n')
+        for i in range(0, len(data), 16):
+            f.write('    ' + ', '.join(f'0x{b:02X}' for b in data[i:i + 16]) + ',\n')
+        f.write('};\n\n')
+        f.write(f'const ssd1306_image_t {name} = {{\n')
+        f.write(f'    .width = {width},\n')
+        f.write(f'    .height = {height},\n')
+        f.write(f'    .rle = {"true" if rle else "false"},\n')
+        f.write(f'    .size = sizeof({name}_data),\n')
+        f.write(f'    .data = {name}_data,\n')
+        f.write('};\n')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('image', help='Arquivo BMP ou PNG.')
+    parser.add_argument('-o', '--out-dir', required=True, help='Diretório de saída.')
+    parser.add_argument('-n', '--name', help='Nome do símbolo (padrão: img_<arquivo>).')
+    parser.add_argument('--rle', action='store_true', help='Comprime com RLE quando reduzir o tamanho.')
+    parser.add_argument('--invert', action='store_true', help='Acende os pixels claros em vez dos escuros.')
+    parser.add_argument('--threshold', type=int, default=128, help='Limiar de luminância (0-255).')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+
+    with open(args.image, 'rb') as f:
+        data = f.read()
+
+    if data[:2] == b'BM':
+        width, height, rows = load_bmp(data)
+    elif data[:8] == b'\x89PNG\r\n\x1a\n':
+        width, height, rows = load_png(data)
+    else:
+        sys.exit(f'{args.image}: formato não reconhecido (use BMP ou PNG)')
+
+    if width > 0xFFFF or height > 0xFFFF:
+        sys.exit(f'{args.image}: imagem grande demais')
+
+    name = args.name or 'img_' + re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.image))[0]).lower()
+    pages = to_pages(width, height, rows, args.threshold, args.invert)
+
+    rle = False
+    if args.rle:
+        packed = rle_encode(pages)
+        if len(packed) < len(pages):
+            pages, rle = packed, True
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    write_sources(args.out_dir, name, width, height, pages, rle)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,148 @@
+// Gerenciador de displays (lib/display_manager) no port Posix do FreeRTOS.
+//
+// Três painéis emulados (tools/ssd1306_emu): um no i2c0 e dois dividindo o
+// i2c1, cada barramento com a sua task de envio. Uma task de prioridade
+// maior que a delas desenha em cada painel uma sequência de quadros e os
+// submete em rajada, sem esperar o barramento: só o mais recente de cada
+// painel sai, os outros são contados como descartados. No fim, a GRAM de
+// cada emulador tem que bater com o golden do painel e cada submissão tem
+// que ter virado um envio ou um descarte.
+//
+// Uso: display_sim [--golden DIR] [--dump DIR]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "display_manager.h"
+
+#define QUADROS 20
+#define PAINEIS 3
+
+typedef struct {
+    const char *nome;
+    i2c_inst_t *i2c;
+    uint8_t addr;
+    uint8_t width;
+    uint8_t height;
+    ssd1306_emu_t emu;
+    ssd1306_t disp;
+    int id;
+} painel_t;
+
+static painel_t paineis[PAINEIS] = {
+    { "painel_a", i2c0, 0x3C, 128, 64 },
+    { "painel_b", i2c1, 0x3C, 128, 64 },
+    { "painel_c", i2c1, 0x3D, 128, 32 },
+};
+
+static const char *dir_golden = NULL;
+static const char *dir_dump = NULL;
+
+static void desenha(painel_t *p, uint32_t quadro) {
+    char texto[24];
+
+    ssd1306_clear(&p->disp);
+    ssd1306_draw_empty_square(&p->disp, 0, 0, p->width - 1, p->height - 1);
+    ssd1306_draw_string(&p->disp, 4, 4, 1, p->nome);
+    snprintf(texto, sizeof(texto), "quadro %u", (unsigned)quadro);
+    ssd1306_draw_string(&p->disp, 4, 16, 1, texto);
+    // Barra proporcional ao quadro, para um quadro intermediário não passar por final
+    ssd1306_draw_square(&p->disp, 4, p->height - 8, (quadro * (p->width - 8u)) / QUADROS, 4);
+}
+
+static int confere(painel_t *p) {
+    char caminho[512];
+    display_stats_t st;
+    int falhas = 0;
+
+    display_manager_get_stats(p->id, &st);
+    printf("%s: %u envios, %u descartados\n", p->nome, (unsigned)st.flushes, (unsigned)st.dropped);
+    if (st.flushes + st.dropped != QUADROS || st.flushes == 0 || st.dropped == 0) {
+        printf("FALHA: %s com %u submissões contadas, esperado %u\n", p->nome,
+               (unsigned)(st.flushes + st.dropped), (unsigned)QUADROS);
+        falhas++;
+    }
+
+    if (dir_dump != NULL) {
+        snprintf(caminho, sizeof(caminho), "%s/%s.pbm", dir_dump, p->nome);
+        if (!ssd1306_emu_save_pbm(&p->emu, caminho)) {
+            falhas++;
+        }
+    }
+    if (dir_golden != NULL) {
+        snprintf(caminho, sizeof(caminho), "%s/%s.pbm", dir_golden, p->nome);
+        long diff = ssd1306_emu_compare_pbm(&p->emu, caminho);
+        printf("golden %s: %ld pixels diferentes\n", caminho, diff);
+        if (diff != 0) {
+            falhas++;
+        }
+    }
+    return falhas;
+}
+
+static void desenho_task(void *pv) {
+    (void)pv;
+
+    // Rajada: todos os quadros de todos os painéis sem ceder o processador
+    for (uint32_t q = 1; q <= QUADROS; q++) {
+        for (int i = 0; i < PAINEIS; i++) {
+            desenha(&paineis[i], q);
+            if (!display_manager_submit(paineis[i].id)) {
+                printf("FALHA: submit do %s\n", paineis[i].nome);
+                exit(1);
+            }
+        }
+    }
+
+    // As tasks de envio só rodam agora e esvaziam tudo antes de voltar
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    int falhas = 0;
+    for (int i = 0; i < PAINEIS; i++) {
+        falhas += confere(&paineis[i]);
+    }
+    printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+    exit(falhas == 0 ? 0 : 1);
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            dir_golden = argv[++i];
+        } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dir_dump = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [--golden DIR] [--dump DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!display_manager_init(2)) {
+        return 1;
+    }
+    for (int i = 0; i < PAINEIS; i++) {
+        painel_t *p = &paineis[i];
+
+        p->disp.external_vcc = false;
+        if (!ssd1306_emu_init(&p->emu, p->width, p->height, p->i2c, p->addr) ||
+            !ssd1306_init(&p->disp, p->width, p->height, p->addr, p->i2c)) {
+            printf("FALHA: init do %s\n", p->nome);
+            return 1;
+        }
+        p->id = display_manager_add(&p->disp);
+        if (p->id < 0) {
+            printf("FALHA: %s não coube no gerenciador\n", p->nome);
+            return 1;
+        }
+    }
+
+    xTaskCreate(desenho_task, "desenho", 2048, NULL, 3, NULL);
+    vTaskStartScheduler();
+    return 0;
+}
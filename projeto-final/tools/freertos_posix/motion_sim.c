@@ -0,0 +1,292 @@
+// Simulação da detecção de colisão por interrupção no port Posix do FreeRTOS.
+//
+// Um MPU6050 simulado recebe a aceleração de uma task "ambiente" (caixa
+// parada com ruído, solavancos e impactos). A colisão usa o mesmo caminho
+// do firmware: executor dos sensores (lib/sensor_sched) + mpu_wrapper +
+// motion_irq + impact, com a captura liberada apenas quando o sensor aciona
+// o pino INT (aqui, motion_irq_simulate); os passos do sensor são os de
+// lib/colisao, compilados também pelo firmware. Um segundo sensor no mesmo
+// barramento é lido a cada 100 ms pelo mesmo executor.
+//
+// Uma task de prioridade baixa com o período do display (100 ms, lib/periodic)
+// mede o jitter de liberação com a colisão ativa.
+//
+// Falha (código de saída 1) se algum impacto injetado não for detectado, se
+// as falhas injetadas no barramento não tiverem o efeito esperado ou se
+// algum sensor perder o prazo.
+//
+// Com --trace, os eventos do kernel (lib/trace) dos últimos instantes saem
+// no fim da simulação, no formato lido por tools/trace_export.
+//
+// Uso: motion_sim [--segundos N] [--trace]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "mpu_wrapper.h"
+#include "motion_irq.h"
+#include "colisao.h"
+#include "mpu6050_sim.h"
+#include "i2c_bus.h"
+#include "trace.h"
+#include "diag.h"
+#include "periodic.h"
+#include "sensor_sched.h"
+
+#define SEGUNDO_PERIODO_MS 100
+#define DISPLAY_PERIODO_MS 100
+
+// Eventos injetados: impacto a cada 2 s e solavanco (sem impacto) entre eles
+#define IMPACTO_A_CADA_MS 2000
+#define IMPACTO_DURACAO_MS 10
+#define SOLAVANCO_DURACAO_MS 20
+
+static mpu6050_sim_t sensor;
+static mpu6050_sim_t sensor_b;    // segundo sensor (0x69), só para a leitura em lote
+static SemaphoreHandle_t xI2CMutex;
+static uint32_t segundos = 10;
+static bool com_trace = false;
+static diag_t diag;
+
+static colisao_ctx_t colisao;
+static uint32_t leituras_b;
+
+static uint32_t impactos_injetados = 0;
+static uint32_t solavancos_injetados = 0;
+static uint32_t impactos_detectados = 0;
+
+// Pino INT do sensor simulado: mesmo efeito da borda no GPIO
+static void sensor_int(void *ctx) {
+    (void)ctx;
+    motion_irq_simulate();
+}
+
+static double ruido(void) {
+    return ((double)rand() / RAND_MAX - 0.5) * 0.01;
+}
+
+static void ambiente_task(void *pv) {
+    (void)pv;
+    TickType_t inicio = xTaskGetTickCount();
+    TickType_t ultimo = inicio;
+    char json[256];
+
+    diag_init(&diag);
+
+    while (true) {
+        uint32_t t = (uint32_t)(xTaskGetTickCount() - inicio);
+        uint32_t fase = t % IMPACTO_A_CADA_MS;
+        double ax = ruido(), ay = ruido(), az = 1.0 + ruido();
+
+        if (t >= segundos * 1000u) {
+            motion_irq_stats_t st;
+            motion_irq_get_stats(&st);
+
+            // Cada leitura do wrapper são duas transações (registrador + dados)
+            printf("\n%u s simulados\n", (unsigned)segundos);
+            printf("impactos: %u injetados, %u detectados; solavancos: %u\n",
+                   (unsigned)impactos_injetados, (unsigned)impactos_detectados, (unsigned)solavancos_injetados);
+            printf("interrupcoes %u, capturas %u, amostras %u, falhas %u\n",
+                   (unsigned)st.eventos, (unsigned)st.capturas, (unsigned)st.amostras,
+                   (unsigned)st.falhas);
+            printf("transacoes I2C apos o init: %u (polling a 10 Hz: %u, perde impactos curtos; "
+                   "polling a %u Hz: %u)\n",
+                   (unsigned)sensor.transacoes, (unsigned)(segundos * 10u * 2u),
+                   (unsigned)(1000u / IMPACTO_PERIODO_MS), (unsigned)(segundos * (1000u / IMPACTO_PERIODO_MS) * 2u));
+            // Mesma mensagem que o firmware publica em pico/diag
+            if (diag_update(&diag) && diag_format_json(&diag, json, sizeof(json)) > 0) {
+                printf("diag: %s\n", json);
+            }
+            // E a de pico/diag/periodos
+            if (periodic_format_json(json, sizeof(json)) > 0) {
+                printf("periodos: %s\n", json);
+            }
+            sensor_sched_stats_t ss;
+            sensor_sched_get_stats(&ss);
+            printf("executor: %u despertares, %u lotes, %u passos, %u erros; 0x69 lido %u vezes\n",
+                   (unsigned)ss.despertares, (unsigned)ss.lotes, (unsigned)ss.passos, (unsigned)ss.erros,
+                   (unsigned)leituras_b);
+            if (com_trace) {
+                trace_stop();
+                trace_dump();
+            }
+
+            int falhas = 0;
+            if (impactos_detectados != impactos_injetados) {
+                printf("FALHA: %u de %u impactos detectados\n", (unsigned)impactos_detectados,
+                       (unsigned)impactos_injetados);
+                falhas++;
+            }
+            for (size_t i = 0; i < periodic_count(); i++) {
+                const periodic_t *p = periodic_get(i);
+                periodic_stats_t ps;
+
+                periodic_get_stats(p, &ps);
+                if (ps.perdas_prazo != 0) {
+                    printf("FALHA: %s perdeu %u prazos de %u ms (exec max %u us)\n", p->nome,
+                           (unsigned)ps.perdas_prazo, (unsigned)(p->prazo_us / 1000u), (unsigned)ps.exec_max_us);
+                    falhas++;
+                }
+            }
+            printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+            exit(falhas == 0 ? 0 : 1);
+        }
+
+        // Com +/- 2 g cada eixo satura em 2 g: o impacto aparece em x e z
+        if (fase >= IMPACTO_A_CADA_MS / 2 && fase < IMPACTO_A_CADA_MS / 2 + IMPACTO_DURACAO_MS) {
+            if (fase == IMPACTO_A_CADA_MS / 2) impactos_injetados++;
+            ax += 1.8;
+            az += 1.0;
+        } else if (fase >= IMPACTO_A_CADA_MS / 4 && fase < IMPACTO_A_CADA_MS / 4 + SOLAVANCO_DURACAO_MS) {
+            if (fase == IMPACTO_A_CADA_MS / 4) solavancos_injetados++;
+            az += 0.6;
+        }
+
+        mpu6050_sim_set_accel(&sensor, ax, ay, az);
+
+        vTaskDelayUntil(&ultimo, 1);
+    }
+}
+
+// Ativações com o período do display do firmware, sem trabalho
+static void display_task(void *pv) {
+    (void)pv;
+    static periodic_t per;
+
+    periodic_init(&per, "display", DISPLAY_PERIODO_MS, 0);
+    while (true) {
+        periodic_wait(&per);
+    }
+}
+
+// Init do sensor de colisão, seguido do início da simulação: os eventos só
+// começam com o INT configurado e as transações contam a partir daqui
+static bool sim_colisao_init(void *ctx) {
+    bool ok = colisao_init(ctx);
+
+    sensor.transacoes = 0;
+    xTaskCreate(ambiente_task, "ambiente", 2048, NULL, 4, NULL);
+    xTaskCreate(display_task, "display", 1024, NULL, 1, NULL);
+    return ok;
+}
+
+static void colisao_resultado(const colisao_ctx_t *c) {
+    if (c->impacto) {
+        impactos_detectados++;
+        printf("Impacto! Mag: %.2f (t = %u ms)\n", c->magnitude, (unsigned)xTaskGetTickCount());
+    }
+}
+
+// Segundo sensor: uma leitura direta por período
+static sensor_passo_t segundo_fetch(void *ctx, uint32_t *espera_ms) {
+    mpu6050_sample_t amostra;
+    (void)espera_ms;
+    return mpu6050_read((mpu6050_dev_t *)ctx, &amostra) ? SENSOR_PRONTO : SENSOR_ERRO;
+}
+
+static void segundo_decode(void *ctx) {
+    (void)ctx;
+    leituras_b++;
+}
+
+static sensor_desc_t sensores[] = {
+    {
+        .nome = "MPU6050",
+        .periodo_ms = MPU_ESPERA_MS,
+        .prazo_ms = MPU_PRAZO_MS,
+        .init = sim_colisao_init,
+        .start = colisao_start,
+        .fetch = colisao_fetch,
+        .decode = colisao_decode,
+        .evento = colisao_evento,
+        .ctx = &colisao,
+    },
+    {
+        .nome = "0x69",
+        .periodo_ms = SEGUNDO_PERIODO_MS,
+        .fetch = segundo_fetch,
+        .decode = segundo_decode,
+    },
+};
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--segundos") == 0 && i + 1 < argc) {
+            segundos = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            com_trace = true;
+        } else {
+            fprintf(stderr, "uso: %s [--segundos N] [--trace]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    srand(7);
+    if (!mpu6050_sim_init(&sensor, i2c0, 0x68, sensor_int, NULL)) {
+        return 1;
+    }
+    colisao.dev = mpu6050_open(i2c0, 0x68);
+    if (colisao.dev == NULL) {
+        return 1;
+    }
+    colisao.resultado = colisao_resultado;
+
+    // Várias instâncias: um segundo sensor no mesmo barramento e um endereço
+    // vazio (que precisa falhar sem travar)
+    mpu6050_sim_init(&sensor_b, i2c0, 0x69, NULL, NULL);
+    mpu6050_dev_t *mpu_b = mpu6050_open(i2c0, 0x69);
+    if (mpu_b == NULL || mpu6050_open(i2c1, 0x68) != NULL) {
+        return 1;
+    }
+    mpu6050_sim_set_accel(&sensor, 0.0, 0.0, 1.0);
+    mpu6050_sim_set_accel(&sensor_b, 0.0, -1.0, 0.0);
+
+    mpu6050_sample_t lote[MPU6050_MAX_SENSORES];
+    bool lote_ok[MPU6050_MAX_SENSORES];
+    size_t n = mpu6050_read_all(lote, lote_ok, MPU6050_MAX_SENSORES);
+    for (size_t i = 0; i < n; i++) {
+        printf("sensor %u: %s, a = (%.2f, %.2f, %.2f) g\n", (unsigned)i, lote_ok[i] ? "ok" : "falha",
+               lote[i].accel[0], lote[i].accel[1], lote[i].accel[2]);
+    }
+
+    // Falhas transitórias no segundo sensor: o timeout força o bus clear e a
+    // repetição da transação inteira, o NACK só a repetição
+    mpu6050_sample_t amostra;
+    i2c_bus_stats_t st;
+    i2c_bus_init(i2c0, 4, 5, 400000);
+    i2c_host_inject_errors(i2c0, 0x69, I2C_BUS_RETRIES, PICO_ERROR_TIMEOUT);
+    bool ok_timeout = mpu6050_read(mpu_b, &amostra);
+    i2c_host_inject_errors(i2c0, 0x69, I2C_BUS_RETRIES + 1, PICO_ERROR_GENERIC);
+    bool ok_nack = mpu6050_read(mpu_b, &amostra);
+    i2c_bus_get_stats(i2c0, 0x69, &st);
+    printf("falhas injetadas: %s apos %d timeouts, %s apos %d NACKs\n",
+           ok_timeout ? "ok" : "falha", I2C_BUS_RETRIES, ok_nack ? "ok" : "falha", I2C_BUS_RETRIES + 1);
+    printf("0x69: %u transacoes, %u erros, %u retentativas, %u recuperacoes, latencia max %u us "
+           "(pior caso de uma leitura: %u us)\n",
+           (unsigned)st.transacoes, (unsigned)st.erros, (unsigned)st.retentativas,
+           (unsigned)st.recuperacoes, (unsigned)st.latencia_max_us,
+           (unsigned)i2c_bus_worst_case_us(i2c0, 1 + 14));
+    if (!ok_timeout || ok_nack) {
+        return 1;
+    }
+
+    xI2CMutex = xSemaphoreCreateMutex();
+    vQueueAddToRegistry(xI2CMutex, "I2C");
+    sensores[1].ctx = mpu_b;
+    if (!sensor_sched_start(sensores, sizeof(sensores) / sizeof(sensores[0]), &xI2CMutex, 1, 3)) {
+        return 1;
+    }
+
+    if (com_trace) {
+        trace_start();
+    }
+
+    vTaskStartScheduler();
+    return 0;
+}
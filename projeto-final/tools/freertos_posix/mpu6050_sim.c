@@ -0,0 +1,122 @@
+#include <math.h>
+#include <string.h>
+
+#include "mpu6050_sim.h"
+
+#define REG_ACCEL_CONFIG 0x1C
+#define REG_MOT_THR      0x1F
+#define REG_INT_PIN_CFG  0x37
+#define REG_INT_ENABLE   0x38
+#define REG_INT_STATUS   0x3A
+#define REG_ACCEL_OUT    0x3B
+#define REG_SIG_PATH_RST 0x68
+#define REG_PWR_MGMT_1   0x6B
+#define REG_WHO_AM_I     0x75
+
+#define INT_MOTION 0x40
+
+static void sim_reset(mpu6050_sim_t *sim) {
+    memset(sim->regs, 0, sizeof(sim->regs));
+    sim->regs[REG_PWR_MGMT_1] = 0x40;
+    sim->regs[REG_WHO_AM_I] = 0x68;
+    sim->int_ativo = false;
+}
+
+static int sim_write(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    mpu6050_sim_t *sim = ctx;
+    (void)nostop;
+
+    sim->transacoes++;
+    if (len == 0) {
+        return 0;
+    }
+
+    sim->ptr = src[0] & 0x7F;
+    for (size_t i = 1; i < len; i++) {
+        uint8_t reg = sim->ptr;
+        sim->ptr = (sim->ptr + 1) & 0x7F;
+
+        if (reg == REG_PWR_MGMT_1 && (src[i] & 0x80)) {
+            sim_reset(sim);
+            continue;
+        }
+        if (reg == REG_SIG_PATH_RST || reg == REG_WHO_AM_I || reg == REG_INT_STATUS) {
+            continue;
+        }
+        sim->regs[reg] = src[i];
+    }
+    return (int)len;
+}
+
+static int sim_read(void *ctx, uint8_t *dst, size_t len, bool nostop) {
+    mpu6050_sim_t *sim = ctx;
+    (void)nostop;
+
+    sim->transacoes++;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t reg = sim->ptr;
+        sim->ptr = (sim->ptr + 1) & 0x7F;
+        dst[i] = sim->regs[reg];
+
+        // Leitura do status libera a trava e o pino
+        if (reg == REG_INT_STATUS) {
+            sim->regs[REG_INT_STATUS] = 0;
+            sim->int_ativo = false;
+        }
+    }
+    return (int)len;
+}
+
+bool mpu6050_sim_init(mpu6050_sim_t *sim, i2c_inst_t *i2c, uint8_t addr,
+                      void (*on_int)(void *ctx), void *ctx) {
+    memset(sim, 0, sizeof(*sim));
+    sim_reset(sim);
+    sim->on_int = on_int;
+    sim->ctx = ctx;
+    sim->anterior[2] = 1.0;
+    return i2c_host_attach(i2c, addr, sim_write, sim_read, sim);
+}
+
+static int16_t sat16(double v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)lround(v);
+}
+
+void mpu6050_sim_set_accel(mpu6050_sim_t *sim, double x, double y, double z) {
+    const double g[3] = { x, y, z };
+    const double lsb = 16384.0 / (1 << ((sim->regs[REG_ACCEL_CONFIG] >> 3) & 3));
+
+    for (int k = 0; k < 3; k++) {
+        int16_t v = sat16(g[k] * lsb);
+        sim->regs[REG_ACCEL_OUT + 2 * k] = (uint8_t)(v >> 8);
+        sim->regs[REG_ACCEL_OUT + 2 * k + 1] = (uint8_t)v;
+    }
+
+    // Detecção de movimento sobre a variação entre amostras (passa-altas)
+    bool hpf = (sim->regs[REG_ACCEL_CONFIG] & 0x07) != 0;
+    if ((sim->regs[REG_INT_ENABLE] & INT_MOTION) && hpf) {
+        double limiar = sim->regs[REG_MOT_THR] * 0.002;
+        bool movimento = false;
+        for (int k = 0; k < 3; k++) {
+            if (fabs(g[k] - sim->anterior[k]) > limiar) movimento = true;
+        }
+
+        if (movimento) {
+            sim->regs[REG_INT_STATUS] |= INT_MOTION;
+            if (!sim->int_ativo) {
+                sim->int_ativo = true;
+                if (sim->on_int) sim->on_int(sim->ctx);
+            }
+        }
+
+        // Sem trava o pino só fica ativo enquanto houver movimento
+        if (!movimento && !(sim->regs[REG_INT_PIN_CFG] & 0x20)) {
+            sim->int_ativo = false;
+        }
+    }
+
+    sim->anterior[0] = x;
+    sim->anterior[1] = y;
+    sim->anterior[2] = z;
+}
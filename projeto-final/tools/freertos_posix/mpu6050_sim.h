@@ -0,0 +1,30 @@
+#ifndef MPU6050_SIM_H
+#define MPU6050_SIM_H
+
+// MPU6050 simulado no barramento I2C do host.
+//
+// Mantém o mapa de registradores (escrita com auto-incremento, reset por
+// PWR_MGMT_1), devolve a amostra definida por mpu6050_sim_set_accel e
+// imita a detecção de movimento: com INT_ENABLE.MOT_EN e o passa-altas
+// ligados, uma variação acima de MOT_THR (2 mg/LSB) trava INT_STATUS e
+// aciona o pino INT, liberado na leitura de INT_STATUS.
+
+#include "hardware/i2c.h"
+
+typedef struct {
+    uint8_t regs[128];
+    uint8_t ptr;
+    bool int_ativo;               // pino INT acionado
+    double anterior[3];           // última aceleração (para o passa-altas)
+    void (*on_int)(void *ctx);    // borda de ativação do pino INT
+    void *ctx;
+    uint32_t transacoes;
+} mpu6050_sim_t;
+
+bool mpu6050_sim_init(mpu6050_sim_t *sim, i2c_inst_t *i2c, uint8_t addr,
+                      void (*on_int)(void *ctx), void *ctx);
+
+// Nova amostra do acelerômetro, em g
+void mpu6050_sim_set_accel(mpu6050_sim_t *sim, double x, double y, double z);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+// GPIO do host: sem pinos reais, as chamadas não têm efeito e as entradas
+// leem nível alto (linhas I2C soltas, com pull-up)
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum gpio_function {
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_SIO = 5,
+};
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_put(uint gpio, bool value) { (void)gpio; (void)value; }
+static inline bool gpio_get(uint gpio) { (void)gpio; return true; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
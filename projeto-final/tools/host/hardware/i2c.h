@@ -0,0 +1,68 @@
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+// Barramento I2C simulado para o host.
+// Cada dispositivo simulado se registra em um endereço de um barramento
+// e recebe as transações de escrita/leitura feitas pelos drivers.
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Códigos de erro com os mesmos valores do Pico SDK
+enum {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+};
+
+typedef struct i2c_inst {
+    uint8_t hw_id;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+// Callbacks de um dispositivo simulado; retornam bytes transferidos ou erro
+typedef int (*i2c_host_write_cb)(void *ctx, const uint8_t *src, size_t len, bool nostop);
+typedef int (*i2c_host_read_cb)(void *ctx, uint8_t *dst, size_t len, bool nostop);
+
+// Registra um dispositivo simulado no barramento
+bool i2c_host_attach(i2c_inst_t *i2c, uint8_t addr, i2c_host_write_cb write, i2c_host_read_cb read, void *ctx);
+
+// Remove todos os dispositivos registrados
+void i2c_host_detach_all(void);
+
+// Faz as próximas 'count' transações com o dispositivo falharem com 'error'
+// (PICO_ERROR_TIMEOUT simula um escravo preso, PICO_ERROR_GENERIC um NACK)
+void i2c_host_inject_errors(i2c_inst_t *i2c, uint8_t addr, uint32_t count, int error);
+
+static inline uint i2c_hw_index(i2c_inst_t *i2c) {
+    return i2c->hw_id;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// Atrasos nas variantes com prazo: cada escrita segura o barramento por
+// write_us (estourando o prazo se ele for menor) e as próximas stall_reads
+// leituras o seguram até o prazo esgotar, como um escravo preso
+void i2c_host_set_delays(i2c_inst_t *i2c, uint8_t addr, uint32_t write_us, uint32_t stall_reads);
+
+// Sem atrasos configurados o barramento simulado responde na hora: o prazo
+// nunca estoura sozinho
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
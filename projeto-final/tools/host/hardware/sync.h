@@ -0,0 +1,24 @@
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+// Substituto do hardware/sync.h. No port Posix do FreeRTOS as "interrupções"
+// são sinais que o kernel já mascara nas seções críticas; fora delas basta
+// uma barreira de compilador.
+
+#include <stdint.h>
+
+static inline uint32_t save_and_disable_interrupts(void) {
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+// Sem metadados de binário no host
+
+#endif
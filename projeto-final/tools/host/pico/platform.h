@@ -0,0 +1,12 @@
+#ifndef HOST_PICO_PLATFORM_H
+#define HOST_PICO_PLATFORM_H
+
+// Substituto do pico/platform.h: no host tudo roda como se fosse o núcleo 0
+
+#include "pico/stdlib.h"
+
+static inline uint get_core_num(void) {
+    return 0;
+}
+
+#endif
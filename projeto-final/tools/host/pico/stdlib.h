@@ -0,0 +1,34 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// Substituto mínimo do pico/stdlib.h para compilar as bibliotecas no Linux.
+// Apenas o necessário para os drivers em lib/ é fornecido aqui.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+typedef unsigned int uint;
+
+// Tempo monotônico em microssegundos (equivalente ao timer de 1 MHz do RP2040)
+static inline uint64_t time_us_64(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)(ts.tv_nsec / 1000);
+}
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+// No host os atrasos não têm efeito: o barramento é simulado e responde na hora
+static inline void sleep_ms(uint32_t ms) {
+    (void)ms;
+}
+
+static inline void sleep_us(uint64_t us) {
+    (void)us;
+}
+
+#endif
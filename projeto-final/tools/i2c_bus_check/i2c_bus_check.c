@@ -0,0 +1,113 @@
+// Conferência dos prazos de lib/i2c_bus no host.
+//
+// O RP2040 tem size_t de 32 bits; no host ele tem 64 e esconderia um
+// estouro no cálculo do tempo de barramento. Os comprimentos passam por
+// i2c_bus_frame_us como uint32_t, como no firmware, e o resultado é
+// comparado com o valor exato para transações de até 4 KiB (o quadro
+// inteiro do SSD1306 tem 1025 bytes) nas velocidades usadas no projeto.
+//
+// Depois, uma leitura de registrador (escrita + leitura) em um escravo
+// lento que trava na fase de leitura em todas as tentativas: a latência
+// medida tem que ficar dentro de i2c_bus_worst_case_us.
+//
+// Uso: i2c_bus_check
+
+#include <stdio.h>
+
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+#define ESCRAVO 0x50
+#define LEITURA_BYTES 14
+
+static const uint velocidades[] = { 100000, 400000, 1000000 };
+
+static int escravo_write(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    (void)ctx;
+    (void)src;
+    (void)nostop;
+    return (int)len;
+}
+
+static int escravo_read(void *ctx, uint8_t *dst, size_t len, bool nostop) {
+    (void)ctx;
+    (void)nostop;
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = (uint8_t)i;
+    }
+    return (int)len;
+}
+
+// Escrita que consome quase todo o prazo da tentativa e leitura presa até
+// o prazo esgotar, em todas as tentativas; retorna as falhas
+static int confere_timeout_na_leitura(void) {
+    uint8_t reg = 0x3B;
+    uint8_t dados[LEITURA_BYTES];
+    i2c_bus_stats_t st;
+
+    i2c_bus_init(i2c0, 14, 15, 400000);
+    i2c_host_attach(i2c0, ESCRAVO, escravo_write, escravo_read, NULL);
+
+    uint32_t prazo = i2c_bus_deadline_us(i2c0, 1 + LEITURA_BYTES + 1);
+    uint32_t pior = i2c_bus_worst_case_us(i2c0, 1 + LEITURA_BYTES);
+
+    i2c_host_set_delays(i2c0, ESCRAVO, prazo * 4 / 5, I2C_BUS_RETRIES + 1);
+    int ret = i2c_bus_write_read(i2c0, ESCRAVO, &reg, 1, dados, sizeof(dados));
+    i2c_host_set_delays(i2c0, ESCRAVO, 0, 0);
+    i2c_bus_get_stats(i2c0, ESCRAVO, &st);
+
+    printf("timeout na leitura: ret %d, %u timeouts, latencia %u us, pior caso %u us (prazo %u us)\n", ret,
+           (unsigned)st.timeouts, (unsigned)st.latencia_max_us, (unsigned)pior, (unsigned)prazo);
+
+    int falhas = 0;
+    if (ret != PICO_ERROR_TIMEOUT || st.timeouts != I2C_BUS_RETRIES + 1u) {
+        printf("FALHA: esperado PICO_ERROR_TIMEOUT em todas as tentativas\n");
+        falhas++;
+    }
+    if (st.latencia_max_us > pior) {
+        printf("FALHA: latencia acima do pior caso\n");
+        falhas++;
+    }
+
+    // Escravo solto: a mesma leitura passa na primeira tentativa
+    if (i2c_bus_write_read(i2c0, ESCRAVO, &reg, 1, dados, sizeof(dados)) != LEITURA_BYTES) {
+        printf("FALHA: leitura sem atrasos\n");
+        falhas++;
+    }
+    return falhas;
+}
+
+int main(void) {
+    int falhas = 0;
+
+    for (size_t v = 0; v < sizeof(velocidades) / sizeof(velocidades[0]); v++) {
+        uint baudrate = velocidades[v];
+
+        i2c_bus_init(i2c0, 14, 15, baudrate);
+        for (uint32_t len = 1; len <= 4096; len++) {
+            uint32_t exato = (uint32_t)((double)(len + 1) * 9.0 * 1e6 / baudrate);
+            uint32_t quadro = i2c_bus_frame_us(len, baudrate);
+            uint32_t prazo = i2c_bus_deadline_us(i2c0, len);
+
+            if (quadro != exato || prazo < 2u * exato) {
+                if (falhas++ < 10) {
+                    printf("FALHA %u Hz, %u bytes: quadro %u us (exato %u), prazo %u us\n", baudrate, len, quadro,
+                           exato, prazo);
+                }
+            }
+        }
+    }
+
+    i2c_bus_init(i2c0, 14, 15, 400000);
+    printf("quadro SSD1306 (1025 bytes) a 400 kHz: %u us, prazo %u us, pior caso %u us\n",
+           i2c_bus_frame_us(1025, 400000), i2c_bus_deadline_us(i2c0, 1025), i2c_bus_worst_case_us(i2c0, 1025));
+
+    falhas += confere_timeout_na_leitura();
+
+    if (falhas != 0) {
+        printf("%d falhas\n", falhas);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
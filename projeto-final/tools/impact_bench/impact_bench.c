@@ -0,0 +1,154 @@
+// Bancada do detector de impacto no host.
+//
+// Gera um fluxo de amostras brutas do acelerômetro (gravidade, ruído,
+// vibração e alguns impactos), processa em blocos pelo caminho antigo
+// (conversão para g, sqrtf e comparação em float, amostra por amostra) e
+// pelo kernel inteiro de lib/impact, confere que os dois detectam as mesmas
+// amostras e mede o custo de cada um.
+//
+// Uso: impact_bench [--samples N] [--block N] [--iter N]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "impact.h"
+
+#define LSB_POR_G 16384
+#define LIMIAR_COLISAO 2.5f
+#define TAXA_HZ 1000
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int16_t sat16(double v) {
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)lround(v);
+}
+
+static double gauss(void) {
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Caixa parada com vibração de transporte e um impacto a cada 2 s
+static void gerar(int16_t *xyz, size_t n) {
+    srand(42);
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i / TAXA_HZ;
+        double vib = 0.15 * sin(2 * M_PI * 17.0 * t);
+        double fase = fmod(t, 2.0);
+        double imp = fase < 0.01 ? 3.0 * sin(M_PI * fase / 0.01) : 0.0;
+
+        xyz[3 * i + 0] = sat16((0.02 * gauss() + imp * 0.6) * LSB_POR_G);
+        xyz[3 * i + 1] = sat16((0.02 * gauss() + vib - imp * 0.5) * LSB_POR_G);
+        xyz[3 * i + 2] = sat16((1.0 + 0.02 * gauss() + imp) * LSB_POR_G);
+    }
+}
+
+// Caminho original da mpu6050_task: float e raiz por amostra
+static int32_t scan_float(const int16_t *xyz, size_t n) {
+    for (size_t i = 0; i < n; i++, xyz += 3) {
+        float ax = (float)xyz[0] / 16384.0f;
+        float ay = (float)xyz[1] / 16384.0f;
+        float az = (float)xyz[2] / 16384.0f;
+        float magnitude = sqrtf((ax * ax) + (ay * ay) + (az * az));
+        if (magnitude > LIMIAR_COLISAO) return (int32_t)i;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    size_t n = 1000000;
+    size_t bloco = 32;
+    uint32_t iteracoes = 20;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            n = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--block") == 0 && i + 1 < argc) {
+            bloco = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
+            iteracoes = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "uso: %s [--samples N] [--block N] [--iter N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n == 0 || bloco == 0 || bloco > 65535 || iteracoes == 0) {
+        fprintf(stderr, "parametros invalidos\n");
+        return 2;
+    }
+
+    int16_t *xyz = malloc(n * 3 * sizeof(int16_t));
+    gerar(xyz, n);
+
+    impact_detector_t det;
+    impact_init(&det, LIMIAR_COLISAO, LSB_POR_G);
+
+    // Equivalência: mesma primeira amostra acima do limiar em cada bloco
+    size_t divergencias = 0, blocos_com_impacto = 0;
+    uint32_t pico = 0, jerk = 0;
+    uint64_t energia_max = 0;
+    for (size_t b = 0; b < n; b += bloco) {
+        size_t m = n - b < bloco ? n - b : bloco;
+        const int16_t *p = xyz + 3 * b;
+        int32_t rf = scan_float(p, m);
+        int32_t ri = impact_scan(&det, p, m);
+        impact_features_t f;
+        impact_process(&det, p, m, &f);
+
+        if (rf != ri || ri != f.primeiro_acima) {
+            divergencias++;
+        }
+        if (ri >= 0) {
+            blocos_com_impacto++;
+        }
+        if (f.pico_mag2 > pico) pico = f.pico_mag2;
+        if (f.jerk_mag2 > jerk) jerk = f.jerk_mag2;
+        if (f.energia > energia_max) energia_max = f.energia;
+    }
+
+    printf("%zu amostras, blocos de %zu\n", n, bloco);
+    printf("blocos com impacto: %zu, divergencias float x inteiro: %zu\n", blocos_com_impacto, divergencias);
+    printf("pico %u mg, jerk max %u mg/amostra, energia max %.3f g^2 por bloco\n",
+           impact_mag2_to_mg(&det, pico), impact_mag2_to_mg(&det, jerk),
+           (double)energia_max / ((double)LSB_POR_G * LSB_POR_G));
+
+    // Custo: percorre o fluxo inteiro sem parar no primeiro impacto
+    volatile int32_t sink = 0;
+    uint64_t t0 = now_ns();
+    for (uint32_t it = 0; it < iteracoes; it++)
+        for (size_t b = 0; b < n; b += bloco)
+            sink += scan_float(xyz + 3 * b, n - b < bloco ? n - b : bloco);
+    double ns_float = (double)(now_ns() - t0) / ((double)iteracoes * n);
+
+    t0 = now_ns();
+    for (uint32_t it = 0; it < iteracoes; it++)
+        for (size_t b = 0; b < n; b += bloco)
+            sink += impact_scan(&det, xyz + 3 * b, n - b < bloco ? n - b : bloco);
+    double ns_scan = (double)(now_ns() - t0) / ((double)iteracoes * n);
+
+    t0 = now_ns();
+    for (uint32_t it = 0; it < iteracoes; it++) {
+        impact_features_t f;
+        for (size_t b = 0; b < n; b += bloco) {
+            impact_process(&det, xyz + 3 * b, n - b < bloco ? n - b : bloco, &f);
+            sink += f.primeiro_acima;
+        }
+    }
+    double ns_proc = (double)(now_ns() - t0) / ((double)iteracoes * n);
+
+    printf("por amostra: float+sqrtf %.2f ns, impact_scan %.2f ns, impact_process %.2f ns (host)\n",
+           ns_float, ns_scan, ns_proc);
+
+    free(xyz);
+    return divergencias ? 1 : 0;
+}
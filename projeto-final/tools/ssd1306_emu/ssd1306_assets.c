@@ -0,0 +1,142 @@
+// Pipeline de imagens do SSD1306 (tools/assets) no host.
+//
+// A imagem de teste (assets/teste.png) é convertida pelo ssd1306_img2c.py
+// na compilação duas vezes: crua (img_teste) e com --rle (img_rle_teste).
+// Confere que a versão RLE saiu de fato comprimida e que as duas desenham o
+// mesmo, byte a byte, pelo ssd1306_blit_image em y alinhado e desalinhado
+// com a página, inclusive cortadas na borda. Depois monta uma cena com as
+// duas, envia ao emulador e compara com o golden.
+//
+// Uso: ssd1306_assets [--dump arquivo.pbm] [--golden arquivo.pbm]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "img_teste.h"
+#include "img_rle_teste.h"
+
+#define OLED_WIDTH  128
+#define OLED_HEIGHT 64
+#define OLED_ADDR   0x3C
+
+typedef struct {
+    int32_t x;
+    int32_t y;
+} posicao_t;
+
+// Alinhadas, desalinhadas e cortadas em cada borda (y negativo inclusive)
+static const posicao_t posicoes[] = {
+    { 0, 0 }, { 44, 8 }, { 0, 27 }, { 44, 35 }, { 96, -3 }, { 100, 50 }, { -5, 13 }, { 10, 60 },
+};
+
+static int falhas = 0;
+
+static void confere(bool ok, const char *o_que) {
+    printf("%-52s %s\n", o_que, ok ? "ok" : "FALHA");
+    if (!ok) {
+        falhas++;
+    }
+}
+
+// Cru e RLE desenham o mesmo na posição dada
+static bool mesmo_desenho(ssd1306_t *disp, uint8_t *copia, const posicao_t *pos) {
+    ssd1306_clear(disp);
+    ssd1306_blit_image(disp, &img_teste, pos->x, pos->y);
+    memcpy(copia, disp->buffer, disp->bufsize);
+
+    ssd1306_clear(disp);
+    ssd1306_blit_image(disp, &img_rle_teste, pos->x, pos->y);
+    return memcmp(copia, disp->buffer, disp->bufsize) == 0;
+}
+
+// Duas de cada na cena: cru e RLE alinhados, desalinhados e cortados
+static void render_scene(ssd1306_t *disp) {
+    ssd1306_clear(disp);
+    ssd1306_blit_image(disp, &img_teste, 0, 0);
+    ssd1306_blit_image(disp, &img_rle_teste, 44, 0);
+    ssd1306_blit_image(disp, &img_teste, 0, 27);
+    ssd1306_blit_image(disp, &img_rle_teste, 44, 27);
+    ssd1306_blit_image(disp, &img_teste, 96, -3);
+    ssd1306_blit_image(disp, &img_rle_teste, 96, 50);
+    ssd1306_show(disp);
+}
+
+int main(int argc, char **argv) {
+    const char *dump_path = NULL;
+    const char *golden_path = NULL;
+    char texto[64];
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dump_path = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [--dump arquivo.pbm] [--golden arquivo.pbm]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    ssd1306_emu_t emu;
+    if (!ssd1306_emu_init(&emu, OLED_WIDTH, OLED_HEIGHT, i2c1, OLED_ADDR)) {
+        fprintf(stderr, "Falha ao iniciar o emulador\n");
+        return 1;
+    }
+
+    ssd1306_t disp;
+    disp.external_vcc = false;
+    if (!ssd1306_init(&disp, OLED_WIDTH, OLED_HEIGHT, OLED_ADDR, i2c1)) {
+        fprintf(stderr, "Falha ao iniciar o display\n");
+        return 1;
+    }
+
+    printf("img_teste: %ux%u, %u bytes; img_rle_teste: %u bytes\n", img_teste.width, img_teste.height,
+           (unsigned)img_teste.size, (unsigned)img_rle_teste.size);
+    confere(!img_teste.rle && img_teste.size == img_teste.width * ((img_teste.height + 7u) / 8u),
+            "cru: uma pagina inteira por faixa de 8 linhas");
+    confere(img_rle_teste.rle && img_rle_teste.size < img_teste.size, "rle: comprimida e menor que a crua");
+    confere(img_rle_teste.width == img_teste.width && img_rle_teste.height == img_teste.height,
+            "rle: mesmas dimensoes");
+
+    uint8_t *copia = malloc(disp.bufsize);
+    if (copia == NULL) {
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(posicoes) / sizeof(posicoes[0]); i++) {
+        snprintf(texto, sizeof(texto), "cru e rle iguais em (%d, %d)", (int)posicoes[i].x, (int)posicoes[i].y);
+        confere(mesmo_desenho(&disp, copia, &posicoes[i]), texto);
+    }
+    free(copia);
+
+    render_scene(&disp);
+
+    if (dump_path) {
+        bool ok = ssd1306_emu_save_pbm(&emu, dump_path);
+        printf("Quadro salvo em %s: %s\n", dump_path, ok ? "ok" : "ERRO");
+        if (!ok) {
+            falhas++;
+        }
+    }
+
+    if (golden_path) {
+        long diff = ssd1306_emu_compare_pbm(&emu, golden_path);
+        if (diff < 0) {
+            printf("Golden %s: arquivo invalido ou de tamanho diferente\n", golden_path);
+            falhas++;
+        } else {
+            printf("Golden %s: %ld pixels diferentes\n", golden_path, diff);
+            if (diff != 0) {
+                falhas++;
+            }
+        }
+    }
+
+    ssd1306_deinit(&disp);
+    printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+    return falhas == 0 ? 0 : 1;
+}
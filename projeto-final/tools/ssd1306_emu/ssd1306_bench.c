@@ -0,0 +1,306 @@
+// Bancada de testes do driver SSD1306 no host.
+//
+// Renderiza uma cena fixa pelo driver real (lib/ssd1306) sobre o emulador,
+// permite salvar o quadro (PBM/PNG) e compará-lo com uma golden image, e mede
+// o custo das primitivas de desenho (pixel, linha, texto, BMP e show).
+//
+// Uso: ssd1306_bench [--iter N] [--dump arquivo.pbm|.png] [--golden arquivo.pbm] [--no-bench]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+#define OLED_WIDTH  128
+#define OLED_HEIGHT 64
+#define OLED_ADDR   0x3C
+
+//=========================================================
+//            Geração de BMP monocromático
+//=========================================================
+
+static void put_le(uint8_t *p, uint32_t v, int n) {
+    for (int i = 0; i < n; i++) {
+        p[i] = (v >> (8 * i)) & 0xFF;
+    }
+}
+
+// Monta um BMP 1 bpp (bottom-up) com um padrão de círculo e moldura
+static long build_bmp(uint8_t *buf, size_t cap, uint32_t w, uint32_t h) {
+    uint32_t stride = ((w + 31) / 32) * 4;
+    uint32_t off = 14 + 40 + 8;
+    uint32_t size = off + stride * h;
+
+    if (size > cap) {
+        return 0;
+    }
+
+    memset(buf, 0, size);
+    buf[0] = 'B';
+    buf[1] = 'M';
+    put_le(buf + 2, size, 4);
+    put_le(buf + 10, off, 4);
+    put_le(buf + 14, 40, 4);
+    put_le(buf + 18, w, 4);
+    put_le(buf + 22, h, 4);
+    put_le(buf + 26, 1, 2);
+    put_le(buf + 28, 1, 2);
+
+    // Paleta: índice 0 preto, índice 1 branco
+    put_le(buf + 54, 0x000000, 4);
+    put_le(buf + 58, 0xFFFFFF, 4);
+
+    int32_t cx = w / 2, cy = h / 2, r = (w < h ? w : h) / 2 - 2;
+    for (uint32_t y = 0; y < h; y++) {
+        uint8_t *line = buf + off + (h - 1 - y) * stride;
+        for (uint32_t x = 0; x < w; x++) {
+            int32_t dx = (int32_t)x - cx, dy = (int32_t)y - cy;
+            bool border = x == 0 || y == 0 || x == w - 1 || y == h - 1;
+            bool inside = dx * dx + dy * dy <= r * r;
+            // Pixel desenhado = índice de cor preta (o driver plota a cor 0x000000)
+            if (!(border || inside)) {
+                line[x >> 3] |= 0x80 >> (x & 7);
+            }
+        }
+    }
+
+    return size;
+}
+
+//=========================================================
+//                     Cena de referência
+//=========================================================
+
+static uint8_t bmp_small[14 + 40 + 8 + 4 * 32];
+static long bmp_small_size;
+static uint8_t bmp_full[14 + 40 + 8 + 16 * 64];
+static long bmp_full_size;
+
+// Mesma imagem do bmp_small, já no formato de página (como o pipeline gera)
+static uint8_t img_small_data[32 * 4];
+static const ssd1306_image_t img_small = {
+    .width = 32,
+    .height = 32,
+    .rle = false,
+    .size = sizeof(img_small_data),
+    .data = img_small_data,
+};
+
+static void build_page_image(ssd1306_t *disp) {
+    ssd1306_clear(disp);
+    ssd1306_bmp_show_image(disp, bmp_small, bmp_small_size);
+    for (uint32_t pg = 0; pg < 4; pg++)
+        memcpy(img_small_data + pg * 32, disp->buffer + pg * disp->width, 32);
+}
+
+static void render_scene(ssd1306_t *disp) {
+    ssd1306_clear(disp);
+
+    // Mesma disposição da display_task
+    ssd1306_draw_string(disp, 10, 10, 1, "Temp: 23.5 C");
+    ssd1306_draw_string(disp, 10, 25, 1, "Umid: 61.0 %");
+    ssd1306_draw_string(disp, 10, 40, 1, "Caixa: Fechada");
+    ssd1306_draw_string(disp, 10, 55, 1, "Colisao: nao");
+
+    ssd1306_draw_empty_square(disp, 0, 0, OLED_WIDTH - 1, OLED_HEIGHT - 1);
+    ssd1306_draw_line(disp, 96, 8, 120, 30);
+    ssd1306_draw_square(disp, 100, 40, 8, 8);
+    ssd1306_bmp_show_image_with_offset(disp, bmp_small, bmp_small_size, 94, 30);
+
+    ssd1306_show(disp);
+}
+
+//=========================================================
+//                    Microbenchmarks
+//=========================================================
+
+typedef void (*bench_fn)(ssd1306_t *disp, uint32_t i);
+
+static void bench_clear(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    ssd1306_clear(disp);
+}
+
+static void bench_pixels(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    for (uint32_t y = 0; y < OLED_HEIGHT; y++)
+        for (uint32_t x = 0; x < OLED_WIDTH; x++)
+            ssd1306_draw_pixel(disp, x, y);
+}
+
+static void bench_lines(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    for (int32_t k = 0; k < OLED_WIDTH; k += 8) {
+        ssd1306_draw_line(disp, 0, 0, k, OLED_HEIGHT - 1);
+        ssd1306_draw_line(disp, k, 0, k, OLED_HEIGHT - 1);
+    }
+}
+
+static void bench_text(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    ssd1306_draw_string(disp, 0, 0, 1, "Temp: 23.5 C Umid: 61 %");
+}
+
+static void bench_text_x2(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    ssd1306_draw_string(disp, 0, 16, 2, "ALERTA!");
+}
+
+static void bench_bmp_small(ssd1306_t *disp, uint32_t i) {
+    ssd1306_bmp_show_image_with_offset(disp, bmp_small, bmp_small_size, i & 63, 16);
+}
+
+static void bench_bmp_full(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    ssd1306_bmp_show_image(disp, bmp_full, bmp_full_size);
+}
+
+static void bench_blit_small(ssd1306_t *disp, uint32_t i) {
+    ssd1306_blit_image(disp, &img_small, i & 63, 16);
+}
+
+static void bench_blit_small_unaligned(ssd1306_t *disp, uint32_t i) {
+    ssd1306_blit_image(disp, &img_small, i & 63, 19);
+}
+
+static void bench_show(ssd1306_t *disp, uint32_t i) {
+    (void)i;
+    ssd1306_show(disp);
+}
+
+typedef struct {
+    const char *name;
+    bench_fn fn;
+    const char *unit;
+    uint32_t units_per_call;
+} bench_case_t;
+
+static const bench_case_t bench_cases[] = {
+    { "clear",          bench_clear,     "frame", 1 },
+    { "draw_pixel",     bench_pixels,    "pixel", OLED_WIDTH * OLED_HEIGHT },
+    { "draw_line",      bench_lines,     "line",  2 * (OLED_WIDTH / 8) },
+    { "draw_string x1", bench_text,      "char",  23 },
+    { "draw_string x2", bench_text_x2,   "char",  7 },
+    { "bmp 32x32",      bench_bmp_small, "image", 1 },
+    { "bmp 128x64",     bench_bmp_full,  "image", 1 },
+    { "blit 32x32",     bench_blit_small, "image", 1 },
+    { "blit 32x32 y%8", bench_blit_small_unaligned, "image", 1 },
+    { "show",           bench_show,      "frame", 1 },
+};
+
+static void run_benchmarks(ssd1306_t *disp, ssd1306_emu_t *emu, uint32_t iterations) {
+    printf("%-16s %12s %14s\n", "operacao", "ns/chamada", "ns/unidade");
+
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        const bench_case_t *b = &bench_cases[c];
+
+        // Aquecimento
+        for (uint32_t i = 0; i < 16; i++)
+            b->fn(disp, i);
+
+        ssd1306_emu_reset_counters(emu);
+        uint64_t t0 = time_us_64();
+        for (uint32_t i = 0; i < iterations; i++)
+            b->fn(disp, i);
+        uint64_t dt = time_us_64() - t0;
+
+        double per_call = (double)dt * 1000.0 / iterations;
+        printf("%-16s %12.1f %10.2f/%s\n", b->name, per_call, per_call / b->units_per_call, b->unit);
+
+        if (emu->transactions > 0) {
+            printf("%-16s %u transacoes, %u bytes de comando, %u bytes de dados por chamada\n", "",
+                   emu->transactions / iterations, emu->cmd_bytes / iterations, emu->data_bytes / iterations);
+        }
+    }
+}
+
+//=========================================================
+//                         main
+//=========================================================
+
+static bool ends_with(const char *s, const char *suffix) {
+    size_t n = strlen(s), m = strlen(suffix);
+    return n >= m && strcmp(s + n - m, suffix) == 0;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = 2000;
+    const char *dump_path = NULL;
+    const char *golden_path = NULL;
+    bool bench = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dump_path = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_path = argv[++i];
+        } else if (strcmp(argv[i], "--no-bench") == 0) {
+            bench = false;
+        } else {
+            fprintf(stderr, "uso: %s [--iter N] [--dump arquivo.pbm|.png] [--golden arquivo.pbm] [--no-bench]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    bmp_small_size = build_bmp(bmp_small, sizeof(bmp_small), 32, 32);
+    bmp_full_size = build_bmp(bmp_full, sizeof(bmp_full), OLED_WIDTH, OLED_HEIGHT);
+
+    ssd1306_emu_t emu;
+    if (!ssd1306_emu_init(&emu, OLED_WIDTH, OLED_HEIGHT, i2c1, OLED_ADDR)) {
+        fprintf(stderr, "Falha ao iniciar o emulador\n");
+        return 1;
+    }
+
+    ssd1306_t disp;
+    disp.external_vcc = false;
+    if (!ssd1306_init(&disp, OLED_WIDTH, OLED_HEIGHT, OLED_ADDR, i2c1)) {
+        fprintf(stderr, "Falha ao iniciar o display\n");
+        return 1;
+    }
+    printf("ssd1306_init: %u transacoes, %u bytes de comando\n", emu.transactions, emu.cmd_bytes);
+
+    build_page_image(&disp);
+
+    ssd1306_emu_reset_counters(&emu);
+    render_scene(&disp);
+
+    int status = 0;
+
+    if (dump_path) {
+        bool ok = ends_with(dump_path, ".png") ? ssd1306_emu_save_png(&emu, dump_path)
+                                               : ssd1306_emu_save_pbm(&emu, dump_path);
+        printf("Quadro salvo em %s: %s\n", dump_path, ok ? "ok" : "ERRO");
+        if (!ok) {
+            status = 1;
+        }
+    }
+
+    if (golden_path) {
+        long diff = ssd1306_emu_compare_pbm(&emu, golden_path);
+        if (diff < 0) {
+            printf("Golden %s: arquivo invalido ou de tamanho diferente\n", golden_path);
+            status = 1;
+        } else {
+            printf("Golden %s: %ld pixels diferentes\n", golden_path, diff);
+            if (diff != 0) {
+                status = 1;
+            }
+        }
+    }
+
+    if (bench) {
+        run_benchmarks(&disp, &emu, iterations);
+    }
+
+    ssd1306_deinit(&disp);
+    return status;
+}
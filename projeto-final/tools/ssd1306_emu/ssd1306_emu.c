@@ -0,0 +1,433 @@
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "ssd1306_emu.h"
+
+// Bits do byte de controle que precede comandos/dados no I2C
+#define CTRL_CO 0x80
+#define CTRL_DC 0x40
+
+//=========================================================
+//              Decodificação de comandos
+//=========================================================
+
+// Quantidade de bytes de argumento de cada comando
+static uint8_t ssd1306_emu_arg_count(uint8_t cmd) {
+    switch (cmd) {
+    case 0x81: // contraste
+    case 0x20: // modo de endereçamento
+    case 0xA8: // multiplex
+    case 0xD3: // offset
+    case 0xDA: // pinos COM
+    case 0xD5: // divisor de clock
+    case 0xD9: // pré-carga
+    case 0xDB: // VCOMH
+    case 0x8D: // charge pump
+        return 1;
+    case 0x21: // janela de colunas
+    case 0x22: // janela de páginas
+    case 0xA3: // área de rolagem vertical
+        return 2;
+    case 0x29: // rolagem vertical + horizontal
+    case 0x2A:
+        return 5;
+    case 0x26: // rolagem horizontal
+    case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void ssd1306_emu_execute(ssd1306_emu_t *emu) {
+    const uint8_t *c = emu->cmd;
+
+    switch (c[0]) {
+    case 0x81:
+        emu->contrast = c[1];
+        return;
+    case 0x20:
+        emu->mem_mode = c[1] & 0x03;
+        return;
+    case 0x21:
+        emu->col_start = c[1] & 0x7F;
+        emu->col_end = c[2] & 0x7F;
+        emu->col = emu->col_start;
+        return;
+    case 0x22:
+        emu->page_start = c[1] & 0x07;
+        emu->page_end = c[2] & 0x07;
+        emu->page = emu->page_start;
+        return;
+    case 0xA8:
+        emu->mux_ratio = (c[1] & 0x3F) + 1;
+        return;
+    case 0xA4:
+    case 0xA5:
+        emu->entire_on = c[0] & 1;
+        return;
+    case 0xA6:
+    case 0xA7:
+        emu->inverted = c[0] & 1;
+        return;
+    case 0xAE:
+    case 0xAF:
+        emu->display_on = c[0] & 1;
+        return;
+    case 0x2E:
+        emu->scroll_active = false;
+        return;
+    case 0x2F:
+        emu->scroll_active = true;
+        return;
+    default:
+        break;
+    }
+
+    if (c[0] >= 0x40 && c[0] <= 0x7F) {
+        emu->start_line = c[0] & 0x3F;
+    } else if (c[0] <= 0x0F) {
+        emu->col = (emu->col & 0xF0) | (c[0] & 0x0F);
+    } else if (c[0] >= 0x10 && c[0] <= 0x1F) {
+        emu->col = (emu->col & 0x0F) | ((c[0] & 0x0F) << 4);
+    } else if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+        emu->page = c[0] & 0x07;
+    }
+    // Demais comandos (clock, pré-carga, remapeamentos...) não alteram a imagem lógica
+}
+
+static void ssd1306_emu_command(ssd1306_emu_t *emu, uint8_t b) {
+    emu->cmd_bytes++;
+
+    if (emu->cmd_need > 0) {
+        emu->cmd[emu->cmd_len++] = b;
+        if (emu->cmd_len > emu->cmd_need) {
+            ssd1306_emu_execute(emu);
+            emu->cmd_need = 0;
+        }
+        return;
+    }
+
+    emu->cmd[0] = b;
+    emu->cmd_len = 1;
+    emu->cmd_need = ssd1306_emu_arg_count(b);
+    if (emu->cmd_need == 0) {
+        ssd1306_emu_execute(emu);
+    }
+}
+
+static void ssd1306_emu_data(ssd1306_emu_t *emu, uint8_t b) {
+    emu->data_bytes++;
+    emu->gram[emu->page][emu->col] = b;
+
+    switch (emu->mem_mode) {
+    case 0: // horizontal
+        if (emu->col++ >= emu->col_end) {
+            emu->col = emu->col_start;
+            emu->page = emu->page >= emu->page_end ? emu->page_start : emu->page + 1;
+        }
+        break;
+    case 1: // vertical
+        if (emu->page++ >= emu->page_end) {
+            emu->page = emu->page_start;
+            emu->col = emu->col >= emu->col_end ? emu->col_start : emu->col + 1;
+        }
+        break;
+    default: // página
+        emu->col = (emu->col + 1) & 0x7F;
+        break;
+    }
+}
+
+// Recebe uma transação de escrita do barramento simulado
+static int ssd1306_emu_write(void *ctx, const uint8_t *src, size_t len, bool nostop) {
+    ssd1306_emu_t *emu = (ssd1306_emu_t *)ctx;
+    size_t i = 0;
+    (void)nostop;
+
+    emu->transactions++;
+
+    while (i < len) {
+        uint8_t ctrl = src[i++];
+
+        if (ctrl & CTRL_CO) {
+            // Co=1: um único byte, seguido de novo byte de controle
+            if (i < len) {
+                if (ctrl & CTRL_DC)
+                    ssd1306_emu_data(emu, src[i]);
+                else
+                    ssd1306_emu_command(emu, src[i]);
+                i++;
+            }
+            continue;
+        }
+
+        // Co=0: o restante da transação é só comando ou só dado
+        for (; i < len; i++) {
+            if (ctrl & CTRL_DC)
+                ssd1306_emu_data(emu, src[i]);
+            else
+                ssd1306_emu_command(emu, src[i]);
+        }
+    }
+
+    return (int)len;
+}
+
+//=========================================================
+//                 API do emulador
+//=========================================================
+
+bool ssd1306_emu_init(ssd1306_emu_t *emu, uint8_t width, uint8_t height, i2c_inst_t *i2c, uint8_t addr) {
+    if (width > SSD1306_EMU_COLS || height > SSD1306_EMU_PAGES * 8) {
+        return false;
+    }
+
+    memset(emu, 0, sizeof(*emu));
+    emu->width = width;
+    emu->height = height;
+    emu->col_end = SSD1306_EMU_COLS - 1;
+    emu->page_end = SSD1306_EMU_PAGES - 1;
+    emu->mem_mode = 2; // padrão de reset do controlador
+    emu->contrast = 0x7F;
+    emu->mux_ratio = 64;
+
+    return i2c_host_attach(i2c, addr, ssd1306_emu_write, NULL, emu);
+}
+
+void ssd1306_emu_reset_counters(ssd1306_emu_t *emu) {
+    emu->transactions = 0;
+    emu->cmd_bytes = 0;
+    emu->data_bytes = 0;
+}
+
+bool ssd1306_emu_get_pixel(const ssd1306_emu_t *emu, uint32_t x, uint32_t y) {
+    if (x >= emu->width || y >= emu->height || !emu->display_on) {
+        return false;
+    }
+
+    // Painéis de 64 colunas ficam centralizados na GRAM (o driver soma 32)
+    uint32_t col = x + (emu->width == 64 ? 32 : 0);
+    uint32_t row = (y + emu->start_line) % emu->mux_ratio;
+
+    bool on = emu->entire_on || ((emu->gram[row >> 3][col] >> (row & 7)) & 1);
+    return on != emu->inverted;
+}
+
+bool ssd1306_emu_save_pbm(const ssd1306_emu_t *emu, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+
+    // No PBM o bit 1 é "tinta": pixels acesos ficam pretos
+    fprintf(f, "P4\n%u %u\n", emu->width, emu->height);
+    for (uint32_t y = 0; y < emu->height; y++) {
+        uint8_t acc = 0;
+        for (uint32_t x = 0; x < emu->width; x++) {
+            acc = (acc << 1) | ssd1306_emu_get_pixel(emu, x, y);
+            if ((x & 7) == 7) {
+                fputc(acc, f);
+                acc = 0;
+            }
+        }
+        if (emu->width & 7) {
+            fputc(acc << (8 - (emu->width & 7)), f);
+        }
+    }
+
+    return fclose(f) == 0;
+}
+
+//=========================================================
+//            PNG sem compressão (deflate "stored")
+//=========================================================
+
+static uint32_t png_crc_table[256];
+
+static void png_crc_init(void) {
+    if (png_crc_table[1] != 0) {
+        return;
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        png_crc_table[n] = c;
+    }
+}
+
+static uint32_t png_crc(uint32_t crc, const uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc = png_crc_table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void png_put32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static void png_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len) {
+    uint8_t hdr[8];
+    png_put32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    fwrite(hdr, 1, 8, f);
+
+    uint32_t crc = png_crc(0xFFFFFFFFu, (const uint8_t *)type, 4);
+    // IEND não tem dados (data == NULL)
+    if (len != 0) {
+        fwrite(data, 1, len, f);
+        crc = png_crc(crc, data, len);
+    }
+    crc ^= 0xFFFFFFFFu;
+    png_put32(hdr, crc);
+    fwrite(hdr, 1, 4, f);
+}
+
+bool ssd1306_emu_save_png(const ssd1306_emu_t *emu, const char *path) {
+    // Linhas brutas: byte de filtro (0) + um byte de cinza por pixel
+    const size_t stride = (size_t)emu->width + 1;
+    const size_t raw_len = stride * emu->height;
+    const size_t blocks = (raw_len + 0xFFFF - 1) / 0xFFFF;
+
+    uint8_t raw[(SSD1306_EMU_COLS + 1) * SSD1306_EMU_PAGES * 8];
+    uint8_t idat[2 + sizeof(raw) + 5 + 4];
+    uint8_t ihdr[13];
+
+    for (uint32_t y = 0; y < emu->height; y++) {
+        raw[y * stride] = 0;
+        for (uint32_t x = 0; x < emu->width; x++) {
+            raw[y * stride + 1 + x] = ssd1306_emu_get_pixel(emu, x, y) ? 0xFF : 0x00;
+        }
+    }
+
+    // zlib: cabeçalho, blocos stored, adler32
+    size_t n = 0;
+    idat[n++] = 0x78;
+    idat[n++] = 0x01;
+    for (size_t b = 0, off = 0; b < blocks; b++) {
+        uint16_t len = (uint16_t)(raw_len - off > 0xFFFF ? 0xFFFF : raw_len - off);
+        idat[n++] = (b == blocks - 1) ? 1 : 0;
+        idat[n++] = len & 0xFF;
+        idat[n++] = len >> 8;
+        idat[n++] = ~len & 0xFF;
+        idat[n++] = (~len >> 8) & 0xFF;
+        memcpy(idat + n, raw + off, len);
+        n += len;
+        off += len;
+    }
+
+    uint32_t s1 = 1, s2 = 0;
+    for (size_t i = 0; i < raw_len; i++) {
+        s1 = (s1 + raw[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    png_put32(idat + n, (s2 << 16) | s1);
+    n += 4;
+
+    png_put32(ihdr, emu->width);
+    png_put32(ihdr + 4, emu->height);
+    ihdr[8] = 8;  // bits por amostra
+    ihdr[9] = 0;  // tons de cinza
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    png_crc_init();
+    fwrite(signature, 1, sizeof(signature), f);
+    png_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+    png_chunk(f, "IDAT", idat, (uint32_t)n);
+    png_chunk(f, "IEND", NULL, 0);
+
+    return fclose(f) == 0;
+}
+
+//=========================================================
+//                 Comparação com golden
+//=========================================================
+
+// Lê o próximo inteiro do cabeçalho PBM, pulando espaços e comentários
+static long pbm_read_int(FILE *f) {
+    int c;
+    for (;;) {
+        c = fgetc(f);
+        if (c == '#') {
+            while (c != '\n' && c != EOF)
+                c = fgetc(f);
+        } else if (!isspace(c)) {
+            break;
+        }
+    }
+
+    if (!isdigit(c)) {
+        return -1;
+    }
+
+    long v = 0;
+    while (isdigit(c)) {
+        v = v * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return v;
+}
+
+long ssd1306_emu_compare_pbm(const ssd1306_emu_t *emu, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return -1;
+    }
+
+    char magic[2];
+    if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || (magic[1] != '1' && magic[1] != '4')) {
+        fclose(f);
+        return -1;
+    }
+
+    long w = pbm_read_int(f);
+    long h = pbm_read_int(f);
+    if (w != emu->width || h != emu->height) {
+        fclose(f);
+        return -1;
+    }
+
+    long diff = 0;
+    for (uint32_t y = 0; y < emu->height; y++) {
+        int byte = 0;
+        for (uint32_t x = 0; x < emu->width; x++) {
+            int bit;
+            if (magic[1] == '4') {
+                if ((x & 7) == 0 && (byte = fgetc(f)) == EOF) {
+                    fclose(f);
+                    return -1;
+                }
+                bit = (byte >> (7 - (x & 7))) & 1;
+            } else {
+                int c;
+                do {
+                    c = fgetc(f);
+                } while (c != EOF && c != '0' && c != '1');
+                if (c == EOF) {
+                    fclose(f);
+                    return -1;
+                }
+                bit = c - '0';
+            }
+            diff += bit != ssd1306_emu_get_pixel(emu, x, y);
+        }
+    }
+
+    fclose(f);
+    return diff;
+}
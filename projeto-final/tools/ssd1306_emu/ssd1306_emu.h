@@ -0,0 +1,69 @@
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+// Emulador do controlador SSD1306 para o host.
+// Decodifica o fluxo de comandos/dados que o driver lib/ssd1306 envia pelo
+// I2C e mantém uma GRAM virtual, que pode ser salva em PBM/PNG ou comparada
+// com uma imagem de referência (golden image).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+#define SSD1306_EMU_COLS  128
+#define SSD1306_EMU_PAGES 8
+
+typedef struct {
+    // Geometria visível do painel
+    uint8_t width;
+    uint8_t height;
+
+    // Memória gráfica do controlador: [página][coluna]
+    uint8_t gram[SSD1306_EMU_PAGES][SSD1306_EMU_COLS];
+
+    // Janela de endereçamento e ponteiros
+    uint8_t mem_mode;        // 0 horizontal, 1 vertical, 2 página
+    uint8_t col_start, col_end, col;
+    uint8_t page_start, page_end, page;
+
+    // Estado do painel
+    uint8_t contrast;
+    uint8_t start_line;
+    uint8_t mux_ratio;
+    bool display_on;
+    bool inverted;
+    bool entire_on;
+    bool scroll_active;
+
+    // Comando multi-byte em andamento
+    uint8_t cmd[8];
+    uint8_t cmd_len;
+    uint8_t cmd_need;
+
+    // Contadores do barramento
+    uint32_t transactions;
+    uint32_t cmd_bytes;
+    uint32_t data_bytes;
+} ssd1306_emu_t;
+
+// Inicializa o emulador e o registra no barramento simulado
+bool ssd1306_emu_init(ssd1306_emu_t *emu, uint8_t width, uint8_t height, i2c_inst_t *i2c, uint8_t addr);
+
+// Zera os contadores de transações/bytes
+void ssd1306_emu_reset_counters(ssd1306_emu_t *emu);
+
+// Valor do pixel visível (x, y), já aplicando linha inicial, inversão e display ligado
+bool ssd1306_emu_get_pixel(const ssd1306_emu_t *emu, uint32_t x, uint32_t y);
+
+// Salva o quadro visível como PBM binário (P4)
+bool ssd1306_emu_save_pbm(const ssd1306_emu_t *emu, const char *path);
+
+// Salva o quadro visível como PNG em tons de cinza (sem compressão)
+bool ssd1306_emu_save_png(const ssd1306_emu_t *emu, const char *path);
+
+// Compara o quadro visível com um PBM (P1 ou P4).
+// Retorna o número de pixels diferentes, ou -1 se o arquivo for inválido.
+long ssd1306_emu_compare_pbm(const ssd1306_emu_t *emu, const char *path);
+
+#endif
@@ -0,0 +1,156 @@
+// Gráfico de varredura (lib/ssd1306/ssd1306_graph) no host.
+//
+// Desenha a moldura com um quadro inteiro e depois empurra mais amostras que
+// a largura do gráfico (mais de uma volta da varredura) com
+// ssd1306_graph_push, sem nenhum ssd1306_show. A cada amostra confere no
+// emulador:
+//   - só a coluna da amostra e a do cursor saem pelo barramento (2 colunas
+//     das páginas do gráfico, em uma janela ou duas na volta), nunca um
+//     quadro inteiro;
+//   - a GRAM do emulador fica igual ao buffer do driver.
+// No fim compara o quadro com o golden.
+//
+// Uso: ssd1306_graph_check [--dump arquivo.pbm] [--golden arquivo.pbm]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_graph.h"
+#include "ssd1306_emu.h"
+
+#define OLED_WIDTH  128
+#define OLED_HEIGHT 64
+#define OLED_ADDR   0x3C
+
+// Área do gráfico: colunas 8..119, páginas 2..5
+#define GRAFICO_X       8
+#define GRAFICO_LARGURA 112
+#define GRAFICO_PAGINA  2
+#define GRAFICO_PAGINAS 4
+#define GRAFICO_MIN     (-100)
+#define GRAFICO_MAX     100
+
+#define AMOSTRAS 300
+
+// Por amostra: janela normal (comando + dados) ou duas na volta da varredura
+#define TRANSACOES_MAX_POR_AMOSTRA 4
+
+static int falhas = 0;
+
+static void confere(bool ok, const char *o_que) {
+    printf("%-60s %s\n", o_que, ok ? "ok" : "FALHA");
+    if (!ok) {
+        falhas++;
+    }
+}
+
+// Triângulo de período 50 com um degrau a cada 64 amostras e saturação nas pontas
+static int32_t amostra(int i) {
+    int32_t fase = i % 50;
+    int32_t v = fase < 25 ? -120 + fase * 10 : 130 - (fase - 25) * 10;
+    if ((i / 64) % 2 == 1) {
+        v = v / 2 + 40;
+    }
+    return v;
+}
+
+static bool gram_igual_ao_buffer(const ssd1306_emu_t *emu, const ssd1306_t *disp) {
+    for (uint32_t pg = 0; pg < disp->pages; pg++) {
+        if (memcmp(emu->gram[pg], disp->buffer + pg * disp->width, disp->width) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *dump_path = NULL;
+    const char *golden_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            dump_path = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [--dump arquivo.pbm] [--golden arquivo.pbm]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    ssd1306_emu_t emu;
+    if (!ssd1306_emu_init(&emu, OLED_WIDTH, OLED_HEIGHT, i2c1, OLED_ADDR)) {
+        fprintf(stderr, "Falha ao iniciar o emulador\n");
+        return 1;
+    }
+
+    ssd1306_t disp;
+    disp.external_vcc = false;
+    if (!ssd1306_init(&disp, OLED_WIDTH, OLED_HEIGHT, OLED_ADDR, i2c1)) {
+        fprintf(stderr, "Falha ao iniciar o display\n");
+        return 1;
+    }
+
+    // Moldura e título num quadro inteiro, o único show do teste
+    ssd1306_graph_t g;
+    ssd1306_clear(&disp);
+    ssd1306_draw_string(&disp, 8, 2, 1, "grafico");
+    ssd1306_draw_empty_square(&disp, GRAFICO_X - 2, GRAFICO_PAGINA * 8 - 2, GRAFICO_LARGURA + 3,
+                              GRAFICO_PAGINAS * 8 + 3);
+    confere(ssd1306_graph_init(&g, &disp, GRAFICO_X, GRAFICO_LARGURA, GRAFICO_PAGINA, GRAFICO_PAGINAS,
+                               GRAFICO_MIN, GRAFICO_MAX), "init: area cabe no display");
+    confere(!ssd1306_graph_init(&(ssd1306_graph_t){0}, &disp, 100, 40, 0, 1, 0, 1),
+            "init: area fora do display recusada");
+    ssd1306_show(&disp);
+
+    uint32_t transacoes_max = 0, bytes_max = 0, bytes_min = UINT32_MAX, bytes_total = 0;
+    bool janela_enderecada = true, gram_ok = true;
+    for (int i = 0; i < AMOSTRAS; i++) {
+        ssd1306_emu_reset_counters(&emu);
+        ssd1306_graph_push(&g, amostra(i));
+
+        if (emu.transactions > transacoes_max) transacoes_max = emu.transactions;
+        if (emu.data_bytes > bytes_max) bytes_max = emu.data_bytes;
+        if (emu.data_bytes < bytes_min) bytes_min = emu.data_bytes;
+        bytes_total += emu.data_bytes;
+        if (emu.cmd_bytes == 0) janela_enderecada = false;
+        if (!gram_igual_ao_buffer(&emu, &disp)) gram_ok = false;
+    }
+
+    printf("%d amostras: %u a %u bytes de dados, ate %u transacoes por amostra (%u bytes no total)\n", AMOSTRAS,
+           (unsigned)bytes_min, (unsigned)bytes_max, (unsigned)transacoes_max, (unsigned)bytes_total);
+    confere(bytes_min == 2 * GRAFICO_PAGINAS && bytes_max == 2 * GRAFICO_PAGINAS,
+            "push: so a coluna da amostra e a do cursor por amostra");
+    confere(transacoes_max <= TRANSACOES_MAX_POR_AMOSTRA && janela_enderecada,
+            "push: janela enderecada, sem quadro inteiro");
+    confere(gram_ok, "push: GRAM do emulador igual ao buffer a cada amostra");
+
+    if (dump_path) {
+        bool ok = ssd1306_emu_save_pbm(&emu, dump_path);
+        printf("Quadro salvo em %s: %s\n", dump_path, ok ? "ok" : "ERRO");
+        if (!ok) {
+            falhas++;
+        }
+    }
+
+    if (golden_path) {
+        long diff = ssd1306_emu_compare_pbm(&emu, golden_path);
+        if (diff < 0) {
+            printf("Golden %s: arquivo invalido ou de tamanho diferente\n", golden_path);
+            falhas++;
+        } else {
+            printf("Golden %s: %ld pixels diferentes\n", golden_path, diff);
+            if (diff != 0) {
+                falhas++;
+            }
+        }
+    }
+
+    ssd1306_deinit(&disp);
+    printf("%s\n", falhas == 0 ? "OK" : "FALHA");
+    return falhas == 0 ? 0 : 1;
+}
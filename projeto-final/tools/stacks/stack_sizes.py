@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Gera task_stacks_gen.h a partir de um log do modo de perfil de pilha.
+
+Lê as linhas "[pilha] <task> <usado> <alocado>" (em palavras) impressas por
+stack_profile_report, fica com o maior uso de cada task e escreve
+`#define PILHA_<TASK> <palavras>` com a margem pedida:
+
+    tamanho = arredonda(usado * (1 + margem) + extra, múltiplo de 32)
+
+nunca abaixo de --minimo. O nome da constante é o da task em maiúsculas,
+como identificador C; um dígito final depois de letra minúscula é removido
+(display_i2c0 e display_i2c1 viram PILHA_DISPLAY_I2C). As tasks IDLE usam
+configMINIMAL_STACK_SIZE e ficam de fora.
+"""
+import argparse
+import math
+import re
+import sys
+
+LINHA = re.compile(r'\[pilha\] (.+) (\d+) (\d+)\s*$')
+
+
+def nome_macro(task):
+    task = re.sub(r'(?<=[a-z])\d$', '', task)
+    return 'PILHA_' + re.sub(r'[^A-Za-z0-9]', '_', task).upper()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('log', help='captura da serial no modo STACK_PROFILE')
+    ap.add_argument('-o', '--output', required=True, help='header gerado')
+    ap.add_argument('--margem', type=float, default=25.0, help='margem sobre o uso medido (%%)')
+    ap.add_argument('--extra', type=int, default=32,
+                    help='palavras fixas somadas (quadro de exceção e contexto salvo)')
+    ap.add_argument('--minimo', type=int, default=256, help='menor pilha gerada (palavras)')
+    args = ap.parse_args()
+
+    medidas = {}
+    with open(args.log, encoding='utf-8', errors='replace') as f:
+        for linha in f:
+            m = LINHA.search(linha)
+            if not m:
+                continue
+            task, usado, alocado = m.group(1), int(m.group(2)), int(m.group(3))
+            if re.fullmatch(r'IDLE\d*', task):
+                continue
+            macro = nome_macro(task)
+            ant = medidas.get(macro)
+            if ant is None or usado > ant[1]:
+                medidas[macro] = (task, usado, alocado)
+
+    if not medidas:
+        sys.exit(f'{args.log}: nenhuma linha "[pilha]" encontrada')
+
+    # Uso que chega ao tamanho alocado indica estouro (ou quase): o valor
+    # medido não é confiável
+    for macro, (task, usado, alocado) in sorted(medidas.items()):
+        if usado >= alocado:
+            sys.exit(f'{task}: usou toda a pilha ({usado} de {alocado}); aumente o padrão e meça de novo')
+
+    linhas = [
+        '// Gerado por tools/stacks/stack_sizes.py; não editar.',
+        f'// Margem de {args.margem:g} % + {args.extra} palavras, mínimo {args.minimo}.',
+        '',
+        '#ifndef TASK_STACKS_GEN_H',
+        '#define TASK_STACKS_GEN_H',
+        '',
+    ]
+    total_antes = total_depois = 0
+    for macro, (task, usado, alocado) in sorted(medidas.items()):
+        tamanho = usado * (1 + args.margem / 100) + args.extra
+        tamanho = max(args.minimo, math.ceil(tamanho / 32) * 32)
+        total_antes += alocado
+        total_depois += tamanho
+        linhas.append(f'#define {macro} {tamanho}  // {task}: usou {usado} de {alocado}')
+    linhas += ['', '#endif', '']
+
+    with open(args.output, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(linhas))
+
+    print(f'{len(medidas)} pilhas: {total_antes * 4} -> {total_depois * 4} bytes')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,35 @@
+# Pilhas das tasks a partir de um log do modo de perfil
+#
+#   task_stacks_from_log(<target> LOG <captura.txt> [MARGEM <pct>])
+#
+# Gera task_stacks_gen.h (tools/stacks/stack_sizes.py) com o uso medido de
+# cada task mais a margem; lib/stack_profile/task_stacks.h o inclui no
+# lugar dos tamanhos padrão. Capture o log com -DSTACK_PROFILE=ON.
+
+set(TASK_STACKS_PY ${CMAKE_CURRENT_LIST_DIR}/stack_sizes.py)
+
+function(task_stacks_from_log target)
+    cmake_parse_arguments(ARG "" "LOG;MARGEM" "" ${ARGN})
+
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+    if(NOT ARG_MARGEM)
+        set(ARG_MARGEM 25)
+    endif()
+
+    get_filename_component(log_path ${ARG_LOG} ABSOLUTE)
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/task_stacks)
+
+    add_custom_command(
+            OUTPUT ${out_dir}/task_stacks_gen.h
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${out_dir}
+            COMMAND ${Python3_EXECUTABLE} ${TASK_STACKS_PY} ${log_path} -o ${out_dir}/task_stacks_gen.h
+                    --margem ${ARG_MARGEM}
+            DEPENDS ${log_path} ${TASK_STACKS_PY}
+            COMMENT "Gerando as pilhas das tasks a partir de ${ARG_LOG}"
+            VERBATIM
+            )
+
+    target_sources(${target} PRIVATE ${out_dir}/task_stacks_gen.h)
+    target_include_directories(${target} PRIVATE ${out_dir})
+endfunction()
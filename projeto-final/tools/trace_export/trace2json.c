@@ -0,0 +1,502 @@
+// Converte o dump do gravador de eventos do kernel (lib/trace) para o
+// formato JSON de trace do Chrome, aberto em ui.perfetto.dev ou
+// chrome://tracing.
+//
+// A entrada é a saída serial capturada: só as linhas "[trace] ..." são
+// usadas e, havendo vários dumps, vale o último completo. No JSON:
+//   - uma trilha por núcleo com as tasks em execução e as ISRs;
+//   - uma trilha por mutex com quem o segurava;
+//   - eventos assíncronos "espera <mutex>" (task bloqueada no take) e
+//     "pronta" (da entrada na lista de prontas até executar);
+//   - operações em filas e semáforos como eventos instantâneos.
+// Um resumo de ocupação, latência de escalonamento e disputa pelos
+// mutexes sai em stderr.
+//
+// Uso: trace2json [captura.txt] [saida.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "trace.h"
+
+#define MAX_ISR_ANINHADAS 8
+
+typedef struct {
+    int64_t ts;         // us desde o primeiro evento
+    uint32_t ordem;     // desempate: ordem no dump
+    trace_event_t ev;
+} evento_t;
+
+typedef struct {
+    char tipo;
+    char nome[TRACE_NOME_MAX + 8];
+} objeto_t;
+
+typedef struct {
+    uint32_t execucoes;
+    int64_t tempo_us;
+    int64_t pronta_ts;          // -1: não está aguardando o núcleo
+    uint32_t latencias;
+    int64_t latencia_soma;
+    int64_t latencia_max;
+    int espera_mutex;           // mutex em que está bloqueada (0: nenhum)
+    int64_t espera_ts;
+} task_stats_t;
+
+typedef struct {
+    uint32_t takes;
+    uint32_t disputas;
+    uint32_t timeouts;
+    int64_t espera_max;
+    int64_t posse_max;
+    int64_t posse_soma;
+    int dono;                   // task que segura o mutex (0: livre)
+    int64_t posse_ts;
+} mutex_stats_t;
+
+static objeto_t objetos[TRACE_MAX_OBJETOS];
+static evento_t *eventos;
+static size_t n_eventos, cap_eventos;
+static uint32_t agora_dump;
+static unsigned long sobrescritos;
+
+static task_stats_t tasks[TRACE_MAX_OBJETOS];
+static mutex_stats_t mutexes[TRACE_MAX_OBJETOS];
+
+static FILE *out;
+static int primeiro_json = 1;
+
+static const char *nome_obj(uint16_t id) {
+    static char buf[4][32];
+    static int i;
+
+    if (id < TRACE_MAX_OBJETOS && objetos[id].nome[0] != '\0') {
+        return objetos[id].nome;
+    }
+
+    const char *tipo = "obj";
+    if (id < TRACE_MAX_OBJETOS) {
+        switch (objetos[id].tipo) {
+        case 't': tipo = "task"; break;
+        case 'q': tipo = "fila"; break;
+        case 'm': tipo = "mutex"; break;
+        case 's': tipo = "semaforo"; break;
+        case 'i': tipo = "isr"; break;
+        }
+    }
+    i = (i + 1) % 4;
+    snprintf(buf[i], sizeof(buf[i]), "%s %u", tipo, (unsigned)id);
+    return buf[i];
+}
+
+static char tipo_obj(uint16_t id) {
+    return id < TRACE_MAX_OBJETOS ? objetos[id].tipo : '?';
+}
+
+// Nomes vêm de strings do firmware: escapa o que quebraria o JSON
+static void json_str(const char *s) {
+    fputc('"', out);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', out);
+            fputc(*s, out);
+        } else if ((unsigned char)*s < 0x20) {
+            fprintf(out, "\\u%04x", (unsigned)*s);
+        } else {
+            fputc(*s, out);
+        }
+    }
+    fputc('"', out);
+}
+
+static void json_inicio(const char *ph, const char *nome, const char *cat, int64_t ts, int tid) {
+    fprintf(out, "%s\n{\"ph\":\"%s\",\"name\":", primeiro_json ? "" : ",", ph);
+    primeiro_json = 0;
+    json_str(nome);
+    fprintf(out, ",\"cat\":\"%s\",\"ts\":%" PRId64 ",\"pid\":1,\"tid\":%d", cat, ts, tid);
+}
+
+static void json_slice(const char *nome, const char *cat, int64_t ts, int64_t dur, int tid) {
+    json_inicio("X", nome, cat, ts, tid);
+    fprintf(out, ",\"dur\":%" PRId64 "}", dur);
+}
+
+static void json_instante(const char *nome, const char *cat, int64_t ts, int tid, const char *task) {
+    json_inicio("i", nome, cat, ts, tid);
+    fprintf(out, ",\"s\":\"t\",\"args\":{\"task\":");
+    json_str(task);
+    fprintf(out, "}}");
+}
+
+static void json_async(const char *ph, const char *nome, const char *cat, int64_t ts, unsigned id) {
+    json_inicio(ph, nome, cat, ts, 0);
+    fprintf(out, ",\"id\":%u}", id);
+}
+
+static void json_nome_trilha(int tid, const char *nome, int ordem) {
+    fprintf(out, "%s\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+            primeiro_json ? "" : ",", tid);
+    primeiro_json = 0;
+    json_str(nome);
+    fprintf(out, "}},\n{\"ph\":\"M\",\"name\":\"thread_sort_index\",\"pid\":1,\"tid\":%d,"
+                 "\"args\":{\"sort_index\":%d}}", tid, ordem);
+}
+
+static int hex_n(const char *s, int n, uint32_t *v) {
+    *v = 0;
+    for (int i = 0; i < n; i++) {
+        char c = s[i];
+        int d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+              : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+        if (d < 0) {
+            return 0;
+        }
+        *v = (*v << 4) | (uint32_t)d;
+    }
+    return 1;
+}
+
+// Lê a captura; retorna 1 se encontrou um dump completo
+static int le_captura(FILE *in) {
+    char linha[1024];
+    int dentro = 0, completo = 0;
+    objeto_t objs_dump[TRACE_MAX_OBJETOS];
+    size_t n_dump = 0;
+    uint32_t agora = 0;
+    unsigned long sobre = 0;
+
+    while (fgets(linha, sizeof(linha), in) != NULL) {
+        char *p = strstr(linha, "[trace] ");
+        if (p == NULL) {
+            continue;
+        }
+        p += 8;
+        p[strcspn(p, "\r\n")] = '\0';
+
+        if (strncmp(p, "inicio ", 7) == 0) {
+            unsigned long n, ob;
+            unsigned long ag;
+            if (sscanf(p + 7, "%lu %lu %lu %lx", &n, &sobre, &ob, &ag) != 4) {
+                continue;
+            }
+            agora = (uint32_t)ag;
+            memset(objs_dump, 0, sizeof(objs_dump));
+            dentro = 1;
+
+            // Eventos do dump em andamento ficam depois dos já aceitos
+            n_dump = n_eventos;
+        } else if (!dentro) {
+            continue;
+        } else if (strncmp(p, "o ", 2) == 0) {
+            unsigned id;
+            char tipo;
+            int pos = 0;
+            if (sscanf(p + 2, "%u %c %n", &id, &tipo, &pos) >= 2 && id < TRACE_MAX_OBJETOS) {
+                objs_dump[id].tipo = tipo;
+                snprintf(objs_dump[id].nome, sizeof(objs_dump[id].nome), "%s", pos > 0 ? p + 2 + pos : "");
+            }
+        } else if (strncmp(p, "e ", 2) == 0) {
+            for (const char *s = p + 2; strlen(s) >= 16; s += 16) {
+                uint32_t t, tipo, core, id;
+                if (!hex_n(s, 8, &t) || !hex_n(s + 8, 2, &tipo) || !hex_n(s + 10, 2, &core) ||
+                    !hex_n(s + 12, 4, &id)) {
+                    break;
+                }
+                if (n_eventos == cap_eventos) {
+                    cap_eventos = cap_eventos ? 2 * cap_eventos : 4096;
+                    eventos = realloc(eventos, cap_eventos * sizeof(*eventos));
+                    if (eventos == NULL) {
+                        perror("realloc");
+                        exit(1);
+                    }
+                }
+                evento_t *e = &eventos[n_eventos];
+                e->ev.t_us = t;
+                e->ev.tipo = (uint8_t)tipo;
+                e->ev.core = (uint8_t)core;
+                e->ev.id = (uint16_t)id;
+                e->ordem = (uint32_t)n_eventos;
+                n_eventos++;
+            }
+        } else if (strcmp(p, "fim") == 0) {
+            // Dump completo: descarta os anteriores
+            memmove(eventos, eventos + n_dump, (n_eventos - n_dump) * sizeof(*eventos));
+            n_eventos -= n_dump;
+            memcpy(objetos, objs_dump, sizeof(objetos));
+            agora_dump = agora;
+            sobrescritos = sobre;
+            dentro = 0;
+            completo = 1;
+        }
+    }
+
+    // Dump cortado no fim da captura: fica o último completo
+    if (dentro) {
+        n_eventos = n_dump;
+    }
+    return completo;
+}
+
+static int compara(const void *a, const void *b) {
+    const evento_t *x = a, *y = b;
+    if (x->ts != y->ts) {
+        return x->ts < y->ts ? -1 : 1;
+    }
+    return x->ordem < y->ordem ? -1 : 1;
+}
+
+static void imprime_resumo(int64_t janela) {
+    fprintf(stderr, "%zu eventos (%lu sobrescritos), janela de %.1f ms\n",
+            n_eventos, sobrescritos, janela / 1000.0);
+
+    fprintf(stderr, "\n%-16s %10s %7s %12s %12s\n", "task", "execucoes", "cpu %", "lat. media", "lat. max");
+    for (uint16_t id = 1; id < TRACE_MAX_OBJETOS; id++) {
+        const task_stats_t *t = &tasks[id];
+        if (tipo_obj(id) != 't' || t->execucoes == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-16s %10u %7.1f %10.0f us %9" PRId64 " us\n", nome_obj(id), (unsigned)t->execucoes,
+                janela > 0 ? 100.0 * t->tempo_us / janela : 0.0,
+                t->latencias ? (double)t->latencia_soma / t->latencias : 0.0, t->latencia_max);
+    }
+
+    fprintf(stderr, "\n%-16s %8s %9s %9s %12s %12s %12s\n", "mutex", "takes", "disputas", "timeouts",
+            "espera max", "posse media", "posse max");
+    for (uint16_t id = 1; id < TRACE_MAX_OBJETOS; id++) {
+        const mutex_stats_t *m = &mutexes[id];
+        if (tipo_obj(id) != 'm' || m->takes + m->disputas == 0) {
+            continue;
+        }
+        fprintf(stderr, "%-16s %8u %9u %9u %9" PRId64 " us %9.0f us %9" PRId64 " us\n", nome_obj(id),
+                (unsigned)m->takes, (unsigned)m->disputas, (unsigned)m->timeouts, m->espera_max,
+                m->takes ? (double)m->posse_soma / m->takes : 0.0, m->posse_max);
+    }
+}
+
+int main(int argc, char **argv) {
+    FILE *in = stdin;
+    out = stdout;
+
+    if (argc > 3 || (argc > 1 && strcmp(argv[1], "--help") == 0)) {
+        fprintf(stderr, "uso: %s [captura.txt] [saida.json]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 1 && strcmp(argv[1], "-") != 0 && (in = fopen(argv[1], "r")) == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    if (!le_captura(in)) {
+        fprintf(stderr, "nenhum dump completo do trace na entrada\n");
+        return 1;
+    }
+    if (argc > 2 && (out = fopen(argv[2], "w")) == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    // Todos os eventos estão a menos de 2^32 us do instante do dump
+    int64_t mais_antigo = 0;
+    for (size_t i = 0; i < n_eventos; i++) {
+        eventos[i].ts = -(int64_t)(uint32_t)(agora_dump - eventos[i].ev.t_us);
+        if (eventos[i].ts < mais_antigo) {
+            mais_antigo = eventos[i].ts;
+        }
+    }
+    for (size_t i = 0; i < n_eventos; i++) {
+        eventos[i].ts -= mais_antigo;
+    }
+    qsort(eventos, n_eventos, sizeof(*eventos), compara);
+
+    int executando[TRACE_CORES] = { 0 };
+    int64_t inicio_exec[TRACE_CORES] = { 0 };
+    int64_t isr_ts[TRACE_CORES][MAX_ISR_ANINHADAS];
+    uint16_t isr_id[TRACE_CORES][MAX_ISR_ANINHADAS];
+    int isr_nivel[TRACE_CORES] = { 0 };
+    int64_t ultimo = 0;
+    char nome[64];
+
+    for (int id = 0; id < TRACE_MAX_OBJETOS; id++) {
+        tasks[id].pronta_ts = -1;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    fprintf(out, "\n{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"args\":{\"name\":\"RP2040\"}}");
+    primeiro_json = 0;
+    for (int c = 0; c < TRACE_CORES; c++) {
+        snprintf(nome, sizeof(nome), "core %d", c);
+        json_nome_trilha(c, nome, c);
+    }
+    for (uint16_t id = 1; id < TRACE_MAX_OBJETOS; id++) {
+        if (tipo_obj(id) == 'm') {
+            snprintf(nome, sizeof(nome), "mutex %s", nome_obj(id));
+            json_nome_trilha(1000 + id, nome, 1000 + id);
+        }
+    }
+
+    for (size_t i = 0; i < n_eventos; i++) {
+        const trace_event_t *e = &eventos[i].ev;
+        int64_t ts = eventos[i].ts;
+        int c = e->core < TRACE_CORES ? e->core : 0;
+        uint16_t id = e->id < TRACE_MAX_OBJETOS ? e->id : 0;
+        int task = executando[c];
+        const char *nome_task = task ? nome_obj((uint16_t)task) : "?";
+        ultimo = ts;
+
+        switch (e->tipo) {
+        case TRACE_EV_TASK_IN:
+            if (task != 0) {
+                json_slice(nome_task, "task", inicio_exec[c], ts - inicio_exec[c], c);
+                tasks[task].tempo_us += ts - inicio_exec[c];
+            }
+            executando[c] = id;
+            inicio_exec[c] = ts;
+            tasks[id].execucoes++;
+            if (tasks[id].pronta_ts >= 0) {
+                int64_t lat = ts - tasks[id].pronta_ts;
+                tasks[id].latencias++;
+                tasks[id].latencia_soma += lat;
+                if (lat > tasks[id].latencia_max) {
+                    tasks[id].latencia_max = lat;
+                }
+                json_async("e", nome_obj(id), "pronta", ts, 0x10000u + id);
+                tasks[id].pronta_ts = -1;
+            }
+            break;
+
+        case TRACE_EV_TASK_OUT:
+            if (task != 0 && task == id) {
+                json_slice(nome_task, "task", inicio_exec[c], ts - inicio_exec[c], c);
+                tasks[task].tempo_us += ts - inicio_exec[c];
+                executando[c] = 0;
+            }
+            break;
+
+        case TRACE_EV_TASK_PRONTA:
+            // A que já está executando só foi reinserida na lista
+            if (tasks[id].pronta_ts < 0 && executando[0] != id && (TRACE_CORES < 2 || executando[1] != id)) {
+                tasks[id].pronta_ts = ts;
+                json_async("b", nome_obj(id), "pronta", ts, 0x10000u + id);
+            }
+            break;
+
+        case TRACE_EV_ISR_ENTER:
+            if (isr_nivel[c] < MAX_ISR_ANINHADAS) {
+                isr_ts[c][isr_nivel[c]] = ts;
+                isr_id[c][isr_nivel[c]] = id;
+            }
+            isr_nivel[c]++;
+            break;
+
+        case TRACE_EV_ISR_EXIT:
+            if (isr_nivel[c] > 0) {
+                isr_nivel[c]--;
+                if (isr_nivel[c] < MAX_ISR_ANINHADAS) {
+                    int n = isr_nivel[c];
+                    snprintf(nome, sizeof(nome), "ISR %s", nome_obj(isr_id[c][n]));
+                    json_slice(nome, "isr", isr_ts[c][n], ts - isr_ts[c][n], c);
+                }
+            }
+            break;
+
+        case TRACE_EV_FILA_RECEBE:
+            if (tipo_obj(id) == 'm') {
+                mutex_stats_t *m = &mutexes[id];
+                m->takes++;
+                m->dono = task;
+                m->posse_ts = ts;
+                if (task != 0 && tasks[task].espera_mutex == id) {
+                    int64_t espera = ts - tasks[task].espera_ts;
+                    if (espera > m->espera_max) {
+                        m->espera_max = espera;
+                    }
+                    snprintf(nome, sizeof(nome), "espera %s", nome_obj(id));
+                    json_async("e", nome, "espera", ts, ((unsigned)task << 8) | id);
+                    tasks[task].espera_mutex = 0;
+                }
+                break;
+            }
+            snprintf(nome, sizeof(nome), "%s %s", tipo_obj(id) == 's' ? "take" : "recebe", nome_obj(id));
+            json_instante(nome, "fila", ts, c, nome_task);
+            break;
+
+        case TRACE_EV_FILA_ENVIO:
+            if (tipo_obj(id) == 'm') {
+                mutex_stats_t *m = &mutexes[id];
+                // O give da criação não tem dono
+                if (m->dono != 0) {
+                    int64_t posse = ts - m->posse_ts;
+                    m->posse_soma += posse;
+                    if (posse > m->posse_max) {
+                        m->posse_max = posse;
+                    }
+                    json_slice(nome_obj((uint16_t)m->dono), "mutex", m->posse_ts, posse, 1000 + id);
+                    m->dono = 0;
+                }
+                break;
+            }
+            snprintf(nome, sizeof(nome), "%s %s", tipo_obj(id) == 's' ? "give" : "envia", nome_obj(id));
+            json_instante(nome, "fila", ts, c, nome_task);
+            break;
+
+        case TRACE_EV_FILA_BLOQUEIO_RECEBE:
+            if (tipo_obj(id) == 'm') {
+                mutexes[id].disputas++;
+                if (task != 0 && tasks[task].espera_mutex != id) {
+                    tasks[task].espera_mutex = id;
+                    tasks[task].espera_ts = ts;
+                    snprintf(nome, sizeof(nome), "espera %s", nome_obj(id));
+                    json_async("b", nome, "espera", ts, ((unsigned)task << 8) | id);
+                }
+            }
+            snprintf(nome, sizeof(nome), "bloqueia em %s", nome_obj(id));
+            json_instante(nome, "bloqueio", ts, c, nome_task);
+            break;
+
+        case TRACE_EV_FILA_RECEBE_FALHA:
+            if (tipo_obj(id) == 'm') {
+                mutexes[id].timeouts++;
+                if (task != 0 && tasks[task].espera_mutex == id) {
+                    snprintf(nome, sizeof(nome), "espera %s", nome_obj(id));
+                    json_async("e", nome, "espera", ts, ((unsigned)task << 8) | id);
+                    tasks[task].espera_mutex = 0;
+                }
+            }
+            snprintf(nome, sizeof(nome), "timeout %s", nome_obj(id));
+            json_instante(nome, "bloqueio", ts, c, nome_task);
+            break;
+
+        case TRACE_EV_FILA_BLOQUEIO_ENVIO:
+        case TRACE_EV_FILA_ENVIO_FALHA:
+            snprintf(nome, sizeof(nome), "%s %s",
+                     e->tipo == TRACE_EV_FILA_ENVIO_FALHA ? "fila cheia" : "bloqueia enviando", nome_obj(id));
+            json_instante(nome, "bloqueio", ts, c, nome_task);
+            break;
+
+        case TRACE_EV_FILA_ENVIO_ISR:
+        case TRACE_EV_FILA_RECEBE_ISR:
+            snprintf(nome, sizeof(nome), "%s %s (ISR)",
+                     e->tipo == TRACE_EV_FILA_ENVIO_ISR ? "envia" : "recebe", nome_obj(id));
+            json_instante(nome, "fila", ts, c, "ISR");
+            break;
+        }
+    }
+
+    // Fecha o que ainda estava executando no instante do dump
+    for (int c = 0; c < TRACE_CORES; c++) {
+        if (executando[c] != 0) {
+            json_slice(nome_obj((uint16_t)executando[c]), "task", inicio_exec[c], ultimo - inicio_exec[c], c);
+            tasks[executando[c]].tempo_us += ultimo - inicio_exec[c];
+        }
+    }
+    fprintf(out, "\n]}\n");
+
+    imprime_resumo(ultimo);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}